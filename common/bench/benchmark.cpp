@@ -0,0 +1,194 @@
+#include<vector>
+#include<string>
+#include<chrono>
+#include<ctime>
+#include<cmath>
+#include<algorithm>
+#include<numeric>
+#include<iomanip>
+#include<cstring>
+
+#include "benchmark.hpp"
+
+using namespace std;
+
+/**
+ * Macro short-hand for printing a decimal x with a precision of y.
+ */
+#define FIXED_FLOAT(x, y) fixed<<setprecision(y)<<(x)
+
+
+/**
+ * Percentiles of the wall-clock times written for every record.
+ */
+const double REPORTED_PERCENTILES[] = {50, 90, 99};
+const char* const PERCENTILE_NAMES[] = {"median", "p90", "p99"};
+
+
+bool parseBenchFormat(const char* name, BENCH_FORMAT& format)
+{
+    if(!strcmp(name, "csv"))
+    {
+        format = BENCH_CSV;
+    }
+    else if(!strcmp(name, "json"))
+    {
+        format = BENCH_JSON;
+    }
+    else if(!strcmp(name, "results"))
+    {
+        format = BENCH_RESULTS;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void runBenchmark(int noWarmup, int noRuns, const function<void()>& setup, const function<void()>& body, BenchRecord& record)
+{
+    for(int i=0;i<noWarmup;i++)
+    {
+        setup();
+        body();
+    }
+
+    for(int i=0;i<noRuns;i++)
+    {
+        setup();
+
+        chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+        clock_t cpuStart = clock();
+        body();
+        clock_t cpuStop = clock();
+        chrono::steady_clock::time_point wallStop = chrono::steady_clock::now();
+
+        record.wallTimes.push_back(chrono::duration<double>(wallStop - wallStart).count());
+        record.cpuTimes.push_back((double)(cpuStop - cpuStart)/CLOCKS_PER_SEC);
+    }
+}
+
+double percentile(vector<double> times, double p)
+{
+    if(times.empty())
+    {
+        return 0;
+    }
+
+    sort(times.begin(), times.end());
+    int rank = ceil(p / 100 * times.size());
+    return times[min(max(rank, 1), (int)times.size()) - 1];
+}
+
+static double mean(const vector<double>& times)
+{
+    return times.empty() ? 0 : accumulate(times.begin(), times.end(), 0.0) / times.size();
+}
+
+/**
+ * \brief Writes a string as a JSON string literal.
+ */
+static void writeJsonString(ostream& out, const string& text)
+{
+    out<<'"';
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\')
+        {
+            out<<'\\';
+        }
+        out<<c;
+    }
+    out<<'"';
+}
+
+static void writeJsonTimes(ostream& out, const vector<double>& times)
+{
+    out<<"{\"min\": "<<percentile(times, 0);
+    for(int i=0;i<3;i++)
+    {
+        out<<", \""<<PERCENTILE_NAMES[i]<<"\": "<<percentile(times, REPORTED_PERCENTILES[i]);
+    }
+    out<<", \"max\": "<<percentile(times, 100)<<", \"mean\": "<<mean(times)<<", \"samples\": [";
+    for(size_t i=0;i<times.size();i++)
+    {
+        out<<(i ? ", " : "")<<times[i];
+    }
+    out<<"]}";
+}
+
+void writeBenchRecords(ostream& out, const vector<BenchRecord>& records, BENCH_FORMAT format)
+{
+    if(format == BENCH_RESULTS)
+    {
+        for(auto& record : records)
+        {
+            out<<record.graph<<" "<<record.noVertices<<" "<<record.noEdges<<" ";
+            for(auto& value : record.values)
+            {
+                out<<value.second<<" ";
+            }
+            out<<FIXED_FLOAT(percentile(record.wallTimes, 50), 6)<<endl;
+        }
+        return;
+    }
+
+    if(format == BENCH_CSV)
+    {
+        out<<"graph,engine,vertices,edges,threads,runs";
+        for(auto& value : records.empty() ? vector<pair<string, long long> >() : records[0].values)
+        {
+            out<<","<<value.first;
+        }
+        out<<",wall_min";
+        for(auto name : PERCENTILE_NAMES)
+        {
+            out<<",wall_"<<name;
+        }
+        out<<",wall_max,wall_mean,cpu_median,cpu_mean"<<endl;
+
+        for(auto& record : records)
+        {
+            out<<record.graph<<","<<record.engine<<","<<record.noVertices<<","<<record.noEdges<<","
+                <<record.noThreads<<","<<record.wallTimes.size();
+            for(auto& value : record.values)
+            {
+                out<<","<<value.second;
+            }
+            out<<fixed<<setprecision(6)<<","<<percentile(record.wallTimes, 0);
+            for(double p : REPORTED_PERCENTILES)
+            {
+                out<<","<<percentile(record.wallTimes, p);
+            }
+            out<<","<<percentile(record.wallTimes, 100)<<","<<mean(record.wallTimes)
+                <<","<<percentile(record.cpuTimes, 50)<<","<<mean(record.cpuTimes)<<endl;
+            out.unsetf(ios_base::floatfield);
+        }
+        return;
+    }
+
+    out<<"["<<endl;
+    for(size_t r=0;r<records.size();r++)
+    {
+        const BenchRecord& record = records[r];
+        out<<"  {\"graph\": ";
+        writeJsonString(out, record.graph);
+        out<<", \"engine\": ";
+        writeJsonString(out, record.engine);
+        out<<", \"vertices\": "<<record.noVertices<<", \"edges\": "<<record.noEdges
+            <<", \"threads\": "<<record.noThreads<<", \"runs\": "<<record.wallTimes.size()<<", \"results\": {";
+        for(size_t i=0;i<record.values.size();i++)
+        {
+            out<<(i ? ", " : "");
+            writeJsonString(out, record.values[i].first);
+            out<<": "<<record.values[i].second;
+        }
+        out<<"},"<<endl<<"   \"wall\": ";
+        writeJsonTimes(out, record.wallTimes);
+        out<<","<<endl<<"   \"cpu\": ";
+        writeJsonTimes(out, record.cpuTimes);
+        out<<"}"<<(r + 1 < records.size() ? "," : "")<<endl;
+    }
+    out<<"]"<<endl;
+}
@@ -0,0 +1,99 @@
+#ifndef benchmark_hpp
+#define benchmark_hpp
+
+#include<vector>
+#include<string>
+#include<utility>
+#include<functional>
+#include<ostream>
+
+/**
+ * \brief Enum representing the format benchmark records are written in.
+ *
+ *      BENCH_CSV - one comma separated line per record, after a header line
+ *      BENCH_JSON - an array with one object per record, including every sample
+ *      BENCH_RESULTS - the space separated lines of the results files read by
+ *          plotting/plot_results.py, with the median wall-clock time as the time
+ *
+ */
+enum BENCH_FORMAT
+{
+    BENCH_CSV,
+    BENCH_JSON,
+    BENCH_RESULTS
+};
+
+/**
+ * \brief Timings and results of one engine run repeatedly on one graph.
+ */
+struct BenchRecord
+{
+    /**
+     * Names of the graph and of the engine.
+     */
+    std::string graph, engine;
+
+    /**
+     * Size of the graph, as reported in the results files.
+     */
+    long long noVertices, noEdges;
+
+    /**
+     * Number of threads the engine was allowed to use.
+     */
+    int noThreads;
+
+    /**
+     * Named results of the engine, such as the number of components or the flow value,
+     * taken from the last run.
+     */
+    std::vector<std::pair<std::string, long long> > values;
+
+    /**
+     * Wall-clock and CPU time of every measured run, in seconds.
+     */
+    std::vector<double> wallTimes, cpuTimes;
+};
+
+/**
+ * \brief Sets format from its name (csv, json or results), and returns whether the name is known.
+ *
+ * @param name - name of the format
+ * @param format - set to the format named
+ */
+bool parseBenchFormat(const char* name, BENCH_FORMAT& format);
+
+/**
+ * \brief Runs an engine noWarmup times untimed and then noRuns times timed, appending
+ * the wall-clock time and the CPU time of every timed run to record.
+ *
+ * CPU time is the time of the whole process, so for a parallel engine it is the sum over
+ * its threads.
+ *
+ * @param noWarmup - number of untimed runs
+ * @param noRuns - number of timed runs
+ * @param setup - run untimed before every run, to rebuild any state the engine consumes
+ * @param body - the engine run being measured
+ * @param record - record the times are appended to
+ */
+void runBenchmark(int noWarmup, int noRuns, const std::function<void()>& setup, const std::function<void()>& body, BenchRecord& record);
+
+/**
+ * \brief Returns the p-th percentile of a list of times by the nearest-rank method,
+ * p = 50 giving the median.
+ *
+ * @param times - list of times, not necessarily sorted
+ * @param p - percentile, between 0 and 100
+ */
+double percentile(std::vector<double> times, double p);
+
+/**
+ * \brief Writes benchmark records in the given format.
+ *
+ * @param out - stream the records are written to
+ * @param records - records to be written, all with the same named values
+ * @param format - format of the output
+ */
+void writeBenchRecords(std::ostream& out, const std::vector<BenchRecord>& records, BENCH_FORMAT format);
+
+#endif
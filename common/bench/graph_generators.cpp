@@ -0,0 +1,191 @@
+#include<vector>
+#include<string>
+#include<random>
+#include<algorithm>
+#include<cstdlib>
+#include<cstring>
+
+#include "graph_generators.hpp"
+
+using namespace std;
+
+
+/**
+ * Probabilities of the first three quadrants of the R-MAT recursion, the fourth taking the rest.
+ */
+const double RMAT_A = 0.57;
+const double RMAT_B = 0.19;
+const double RMAT_C = 0.19;
+
+
+/**
+ * \brief Splits a specification at ':' into its kind and its numbers, and returns whether
+ * all the numbers are positive.
+ */
+static bool splitSpec(const char* spec, string& kind, vector<long long>& numbers)
+{
+    string text(spec);
+    size_t colon = text.find(':');
+    kind = text.substr(0, colon);
+    numbers.clear();
+
+    while(colon != string::npos)
+    {
+        size_t next = text.find(':', colon + 1);
+        long long number = atoll(text.substr(colon + 1, next - colon - 1).c_str());
+        if(number <= 0)
+        {
+            return false;
+        }
+        numbers.push_back(number);
+        colon = next;
+    }
+    return true;
+}
+
+static void generateRmat(int scale, long long noEdges, mt19937_64& random, vector<int>& sources, vector<int>& targets)
+{
+    uniform_real_distribution<double> uniform(0, 1);
+    for(long long i=0;i<noEdges;i++)
+    {
+        int x = 0, y = 0;
+        for(int level=0;level<scale;level++)
+        {
+            double r = uniform(random);
+            int right = r >= RMAT_A && (r < RMAT_A + RMAT_B || r >= RMAT_A + RMAT_B + RMAT_C);
+            int down = r >= RMAT_A + RMAT_B;
+            x = x << 1 | down;
+            y = y << 1 | right;
+        }
+        sources.push_back(x);
+        targets.push_back(y);
+    }
+
+    vector<int> permutation(1 << scale);
+    for(size_t v=0;v<permutation.size();v++)
+    {
+        permutation[v] = v;
+    }
+    shuffle(permutation.begin(), permutation.end(), random);
+    for(long long i=0;i<noEdges;i++)
+    {
+        sources[i] = permutation[sources[i]];
+        targets[i] = permutation[targets[i]];
+    }
+}
+
+static void generateGrid(int rows, int cols, vector<int>& sources, vector<int>& targets)
+{
+    for(int r=0;r<rows;r++)
+    {
+        for(int c=0;c<cols;c++)
+        {
+            int v = r * cols + c;
+            if(c + 1 < cols)
+            {
+                sources.push_back(v);
+                targets.push_back(v + 1);
+            }
+            if(r + 1 < rows)
+            {
+                sources.push_back(v);
+                targets.push_back(v + cols);
+            }
+        }
+    }
+}
+
+bool generateGraph(const char* spec, const GeneratorOptions& options, EdgeList& edges, string& name)
+{
+    string kind;
+    vector<long long> numbers;
+    if(!splitSpec(spec, kind, numbers))
+    {
+        return false;
+    }
+
+    mt19937_64 random(options.seed);
+    vector<int> sources, targets;
+    long long noVertices;
+
+    if(kind == "rmat" && numbers.size() == 2 && numbers[0] < 31)
+    {
+        noVertices = 1LL << numbers[0];
+        generateRmat(numbers[0], noVertices * numbers[1], random, sources, targets);
+    }
+    else if(kind == "er" && numbers.size() == 2)
+    {
+        noVertices = numbers[0];
+        uniform_int_distribution<long long> vertex(0, noVertices - 1);
+        for(long long i=0;i<numbers[1];i++)
+        {
+            sources.push_back(vertex(random));
+            targets.push_back(vertex(random));
+        }
+    }
+    else if(kind == "grid" && numbers.size() == 2)
+    {
+        noVertices = numbers[0] * numbers[1];
+        generateGrid(numbers[0], numbers[1], sources, targets);
+    }
+    else if(kind == "bipartite" && numbers.size() == 3)
+    {
+        uniform_int_distribution<long long> left(1, numbers[0]), right(1, numbers[1]);
+        for(long long i=0;i<numbers[2];i++)
+        {
+            sources.push_back(left(random));
+            targets.push_back(right(random));
+        }
+
+        edges.header.assign(numbers.begin(), numbers.end());
+        noVertices = numbers[0] + numbers[1];
+    }
+    else
+    {
+        return false;
+    }
+
+    if(noVertices > 2147483647LL || (long long)sources.size() > 2147483647LL)
+    {
+        return false;
+    }
+
+    if(options.backProbability >= 0 && kind != "bipartite")
+    {
+        bernoulli_distribution back(options.backProbability);
+        for(size_t i=0;i<sources.size();i++)
+        {
+            int x = min(sources[i], targets[i]), y = max(sources[i], targets[i]);
+            bool reversed = back(random);
+            sources[i] = reversed ? y : x;
+            targets[i] = reversed ? x : y;
+        }
+    }
+
+    if(kind != "bipartite")
+    {
+        edges.header.assign(1, noVertices);
+        edges.header.push_back(sources.size());
+    }
+
+    edges.columns.clear();
+    edges.weights.clear();
+    edges.columns.push_back(vector<int>());
+    edges.columns.push_back(vector<int>());
+    edges.columns[0].swap(sources);
+    edges.columns[1].swap(targets);
+
+    if(options.maxCapacity > 0)
+    {
+        uniform_int_distribution<int> capacity(1, options.maxCapacity);
+        edges.weights.resize(edges.noEdges());
+        for(auto& c : edges.weights)
+        {
+            c = capacity(random);
+        }
+    }
+
+    name = spec;
+    replace(name.begin(), name.end(), ':', '-');
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef graph_generators_hpp
+#define graph_generators_hpp
+
+#include<string>
+
+#include "edge_loader.hpp"
+
+/**
+ * \brief Options shared by all the synthetic graph generators.
+ */
+struct GeneratorOptions
+{
+    /**
+     * If non-negative, every edge is first directed from its smaller to its larger vertex,
+     * and then reversed with this probability. 0 gives a DAG, and larger values give larger
+     * strong components. If negative, edges keep the direction they were generated with.
+     */
+    double backProbability;
+
+    /**
+     * If positive, capacities drawn uniformly from 1 .. maxCapacity are generated as the weights.
+     */
+    int maxCapacity;
+
+    /**
+     * Seed of the random number generator.
+     */
+    unsigned seed;
+
+    GeneratorOptions() : backProbability(-1), maxCapacity(0), seed(1) {}
+};
+
+/**
+ * \brief Generates a synthetic graph from a specification, and returns whether the
+ * specification is valid.
+ *
+ * Directed graphs are produced as an edge-list file with header V E would be read, with
+ * vertices numbered from 0. Bipartite graphs are produced as a bipartite_matching file with
+ * header N1 N2 E would be read, with both sides numbered from 1. The specifications are
+ *
+ *      rmat:SCALE:EDGEFACTOR - R-MAT graph (a, b, c = 0.57, 0.19, 0.19) with 2^SCALE vertices
+ *          and EDGEFACTOR edges per vertex, its vertices randomly permuted
+ *      er:V:E - Erdos-Renyi digraph with V vertices and E uniformly random edges
+ *      grid:ROWS:COLS - grid whose vertices have edges to their right and lower neighbours
+ *      bipartite:N1:N2:E - bipartite graph with E uniformly random edges between the sides
+ *
+ * @param spec - specification of the graph
+ * @param options - options of the generator
+ * @param edges - filled with the header, the columns and the weights of the graph
+ * @param name - filled with a name for the graph, derived from spec
+ */
+bool generateGraph(const char* spec, const GeneratorOptions& options, EdgeList& edges, std::string& name);
+
+#endif
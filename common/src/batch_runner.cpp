@@ -0,0 +1,248 @@
+#include<vector>
+#include<string>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<iostream>
+#include<fstream>
+#include<algorithm>
+#include<functional>
+#include<condition_variable>
+
+#include<dirent.h>
+#include<sys/stat.h>
+
+#include "batch_runner.hpp"
+#include "thread_pool.hpp"
+#include "graph_snapshot.hpp"
+
+using namespace std;
+
+
+/**
+ * Number of edges from which a graph is solved alone with every thread.
+ */
+const long long BATCH_SMALL_GRAPH = 1 << 20;
+
+/**
+ * Maximum number of large graphs loaded at once, the one being solved and the next one.
+ */
+const int MAX_LARGE_LOADED = 2;
+
+
+/**
+ * \brief Returns whether a path names a regular file.
+ */
+static bool isRegularFile(const string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+bool listBatchFiles(const char* path, vector<string>& fileNames)
+{
+    fileNames.clear();
+
+    struct stat info;
+    if(stat(path, &info) == -1)
+    {
+        return false;
+    }
+
+    if(S_ISDIR(info.st_mode))
+    {
+        DIR* directory = opendir(path);
+        if(!directory)
+        {
+            return false;
+        }
+
+        vector<string> names;
+        while(struct dirent* entry = readdir(directory))
+        {
+            if(entry->d_name[0] != '.')
+            {
+                names.push_back(entry->d_name);
+            }
+        }
+        closedir(directory);
+        sort(names.begin(), names.end());
+
+        string prefix = string(path) + "/";
+        for(auto& name : names)
+        {
+            string cacheOf = name.size() > 4 ? name.substr(0, name.size() - 4) : "";
+            if(!cacheOf.empty() && snapshotPath(cacheOf.c_str()) == name && binary_search(names.begin(), names.end(), cacheOf))
+            {
+                continue;
+            }
+            if(isRegularFile(prefix + name))
+            {
+                fileNames.push_back(prefix + name);
+            }
+        }
+        return !fileNames.empty();
+    }
+
+    ifstream manifest(path);
+    if(!manifest.is_open())
+    {
+        return false;
+    }
+
+    string manifestPath(path);
+    size_t slash = manifestPath.rfind('/');
+    string directory = slash == string::npos ? "" : manifestPath.substr(0, slash + 1);
+
+    string line;
+    while(getline(manifest, line))
+    {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        fileNames.push_back(line[0] == '/' ? line : directory + line);
+    }
+    return !fileNames.empty();
+}
+
+void reportBatchFailure(const string& fileName, const string& reason)
+{
+    cerr<<"Warning - "<<fileName<<" - "<<reason<<endl;
+}
+
+int runBatch(const vector<string>& fileNames, int noThreads, const BatchLoader& load, const char* resultsFile)
+{
+    int noFiles = fileNames.size();
+    int maxLoaded = 2 * noThreads + 1;
+
+    /*
+     * Graphs handed from the loader to the dispatcher, and the number of graphs loaded
+     * but not yet solved, all guarded by stateLock.
+     */
+    mutex stateLock;
+    condition_variable stateChanged;
+    deque<pair<BatchTask, long long> > loaded;
+    int noLoaded = 0, noLargeLoaded = 0;
+
+    auto finished = [&](bool large)
+    {
+        lock_guard<mutex> guard(stateLock);
+        noLoaded--;
+        noLargeLoaded -= large;
+        stateChanged.notify_all();
+    };
+
+    thread loader([&]
+    {
+        for(auto& fileName : fileNames)
+        {
+            {
+                unique_lock<mutex> guard(stateLock);
+                stateChanged.wait(guard, [&] { return noLoaded < maxLoaded && noLargeLoaded < MAX_LARGE_LOADED; });
+            }
+
+            long long noEdges = 0;
+            BatchTask task = load(fileName, noEdges);
+
+            lock_guard<mutex> guard(stateLock);
+            loaded.push_back(make_pair(task, noEdges));
+            noLoaded++;
+            noLargeLoaded += noEdges >= BATCH_SMALL_GRAPH;
+            stateChanged.notify_all();
+        }
+    });
+
+    /*
+     * Results lines of every graph, written out in file order as soon as all the
+     * graphs before them have finished.
+     */
+    mutex resultsLock;
+    vector<string> lines(noFiles);
+    vector<bool> done(noFiles, false);
+    int noWritten = 0, noFailed = 0;
+    ofstream results;
+    if(resultsFile)
+    {
+        results.open(resultsFile, ios_base::app);
+        if(!results.is_open())
+        {
+            cerr<<"Warning - Cannot open results file."<<endl;
+        }
+    }
+
+    auto record = [&](int index, const string& line)
+    {
+        lock_guard<mutex> guard(resultsLock);
+        lines[index] = line;
+        done[index] = true;
+        noFailed += line.empty();
+        while(noWritten < noFiles && done[noWritten])
+        {
+            if(!lines[noWritten].empty())
+            {
+                cout<<lines[noWritten]<<endl;
+                if(results.is_open())
+                {
+                    results<<lines[noWritten]<<endl;
+                }
+            }
+            noWritten++;
+        }
+    };
+
+    ThreadPool pool(noThreads);
+    TaskGroup smallGraphs;
+    for(int i=0;i<noFiles;i++)
+    {
+        pair<BatchTask, long long> next;
+        {
+            unique_lock<mutex> guard(stateLock);
+            stateChanged.wait(guard, [&] { return !loaded.empty(); });
+            next = loaded.front();
+            loaded.pop_front();
+        }
+
+        BatchTask task = next.first;
+        bool large = next.second >= BATCH_SMALL_GRAPH;
+        if(!task)
+        {
+            finished(large);
+            record(i, "");
+            continue;
+        }
+
+        if(large)
+        {
+            pool.wait(smallGraphs);
+            record(i, task(noThreads));
+            finished(true);
+            continue;
+        }
+
+        /*
+         * Keep at most 2 * noThreads small graphs queued, draining the pool with the help
+         * of this thread whenever it is full.
+         */
+        if(smallGraphs.pending >= 2 * pool.size())
+        {
+            pool.wait(smallGraphs);
+        }
+        pool.submit(smallGraphs, [&, task, i]
+        {
+            record(i, task(1));
+            finished(false);
+        });
+    }
+    pool.wait(smallGraphs);
+
+    loader.join();
+
+    if(noFailed)
+    {
+        cerr<<"Warning - "<<noFailed<<" of "<<noFiles<<" graphs could not be solved."<<endl;
+    }
+    return noFailed;
+}
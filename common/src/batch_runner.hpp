@@ -0,0 +1,67 @@
+#ifndef batch_runner_hpp
+#define batch_runner_hpp
+
+#include<vector>
+#include<string>
+#include<functional>
+
+/**
+ * \brief Solves a loaded graph with the given number of threads, and returns its results
+ * line, or an empty string if it could not be solved.
+ */
+typedef std::function<std::string(int noThreads)> BatchTask;
+
+/**
+ * \brief Loads a graph file, setting noEdges to its number of edges, and returns the task
+ * solving it, or an empty task if it could not be loaded.
+ */
+typedef std::function<BatchTask(const std::string& fileName, long long& noEdges)> BatchLoader;
+
+/**
+ * \brief Lists the graph files of a batch, and returns false if there are none.
+ *
+ * A directory contributes its regular files in name order, skipping hidden files and
+ * the snapshots cached next to a text graph file of the directory. Any other file is a
+ * manifest holding one graph path per line, relative to the manifest's directory, with
+ * blank lines and lines starting with '#' skipped.
+ *
+ * @param path - directory or manifest
+ * @param fileNames - filled with the paths of the graph files
+ */
+bool listBatchFiles(const char* path, std::vector<std::string>& fileNames);
+
+/**
+ * \brief Reports a graph of a batch which could not be loaded or solved, as
+ * "Warning - fileName - reason" on the standard error.
+ *
+ * The loader and the task of a graph call it before returning an empty task or results
+ * line, so that every graph counted as failed by runBatch is named with its cause.
+ *
+ * @param fileName - path of the graph file
+ * @param reason - cause of the failure
+ */
+void reportBatchFailure(const std::string& fileName, const std::string& reason);
+
+/**
+ * \brief Solves a batch of graphs in one process.
+ *
+ * A loader thread loads the graphs in order, running ahead of the solvers by at most
+ * 2 * noThreads + 1 graphs, of which at most two are large, so the next graph is parsed
+ * while the current one is solved. Graphs with fewer than BATCH_SMALL_GRAPH edges are
+ * solved concurrently on a thread pool with one thread each, and every larger graph is
+ * solved alone with all noThreads threads once the small ones before it have finished.
+ *
+ * The results lines are printed and appended to resultsFile in the order of the files,
+ * whatever order the graphs finish in. A graph which cannot be loaded or solved is skipped,
+ * and the batch goes on with the next one.
+ *
+ * Returns the number of graphs which could not be loaded or solved.
+ *
+ * @param fileNames - paths of the graph files
+ * @param noThreads - number of threads used for solving
+ * @param load - loads a graph and returns the task solving it
+ * @param resultsFile - file the results lines are appended to, or nullptr
+ */
+int runBatch(const std::vector<std::string>& fileNames, int noThreads, const BatchLoader& load, const char* resultsFile);
+
+#endif
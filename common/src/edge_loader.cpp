@@ -0,0 +1,337 @@
+#include<vector>
+#include<thread>
+#include<algorithm>
+#include<cstring>
+#include<functional>
+
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include "edge_loader.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+/**
+ * Minimum number of bytes handed to one parsing thread.
+ */
+const long long MIN_CHUNK_SIZE = 1 << 20;
+
+
+int EdgeList::noEdges() const
+{
+    return columns.empty() ? 0 : columns[0].size();
+}
+
+/**
+ * \brief Returns the position just past the end of the line starting at p.
+ */
+static inline const char* skipLine(const char* p, const char* end)
+{
+    const char* newline = (const char*)memchr(p, '\n', end - p);
+    return newline ? newline + 1 : end;
+}
+
+/**
+ * \brief Parses an optionally negative integer at p, skipping any blanks before it,
+ * and returns false if the line ends first.
+ */
+static inline bool parseNumber(const char*& p, const char* end, long long& value)
+{
+    while(p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ','))
+    {
+        p++;
+    }
+
+    bool negative = p < end && *p == '-';
+    p += negative;
+
+    unsigned digit;
+    if(p == end || (digit = (unsigned char)*p - '0') > 9)
+    {
+        return false;
+    }
+
+    long long number = 0;
+    do
+    {
+        number = number * 10 + digit;
+        p++;
+    }
+    while(p < end && (digit = (unsigned char)*p - '0') <= 9);
+
+    value = negative ? -number : number;
+    return true;
+}
+
+/**
+ * \brief Parses up to noValues numbers from the line starting at p, and returns the
+ * position of the next line. complete is set if all of them were found on a line
+ * that is not a comment.
+ */
+static inline const char* parseLine(const char* p, const char* end, int noValues, long long* values, bool& complete)
+{
+    const char* first = p;
+    while(first < end && (*first == ' ' || *first == '\t'))
+    {
+        first++;
+    }
+
+    complete = false;
+    if(first < end && *first != '#' && *first != '%')
+    {
+        int found = 0;
+        while(found < noValues && parseNumber(p, end, values[found]))
+        {
+            found++;
+        }
+        complete = found == noValues;
+    }
+
+    return skipLine(p, end);
+}
+
+/**
+ * \brief Parses the edge lines starting in [begin, end) into the given columns, and their
+ * weights if weights is not nullptr.
+ */
+static void parseChunk(const char* begin, const char* end, const char* fileEnd, vector<vector<int> >& columns,
+    vector<long long>* weights)
+{
+    int noColumns = columns.size();
+    vector<long long> values(noColumns + 1);
+
+    const char* p = begin;
+    while(p < end)
+    {
+        bool complete;
+        p = parseLine(p, fileEnd, noColumns + (weights != nullptr), values.data(), complete);
+        if(complete)
+        {
+            for(int c=0;c<noColumns;c++)
+            {
+                columns[c].push_back(values[c]);
+            }
+            if(weights)
+            {
+                weights->push_back(values[noColumns]);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Memory-maps a file for sequential reading, and returns the mapping, or nullptr
+ * if the file cannot be opened or is empty.
+ */
+static const char* mapFile(const char* fileName, long long& size)
+{
+    int fd = open(fileName, O_RDONLY);
+    if(fd == -1)
+    {
+        return nullptr;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) == -1 || info.st_size == 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    return (const char*)mapping;
+}
+
+/**
+ * \brief Parses the header line, skipping the comments before it, and returns the position
+ * of the next line, or nullptr if the header is incomplete.
+ */
+static const char* parseHeader(const char* data, const char* end, int noHeaderValues, vector<long long>& header)
+{
+    header.assign(noHeaderValues, 0);
+
+    const char* body = data;
+    bool complete = false;
+    while(body < end && !complete)
+    {
+        body = parseLine(body, end, noHeaderValues, header.data(), complete);
+    }
+    return complete ? body : nullptr;
+}
+
+bool loadEdgeList(const char* fileName, int noHeaderValues, int noColumns, EdgeList& edges, int noThreads, bool weighted)
+{
+    PERF_REGION("load");
+    long long size;
+    const char* data = mapFile(fileName, size);
+    if(!data)
+    {
+        return false;
+    }
+    void* mapping = (void*)data;
+    const char* end = data + size;
+
+    edges.columns.assign(noColumns, vector<int>());
+    edges.weights.clear();
+
+    const char* body = parseHeader(data, end, noHeaderValues, edges.header);
+    if(!body)
+    {
+        munmap(mapping, size);
+        return false;
+    }
+
+    if(noThreads <= 0)
+    {
+        noThreads = max((int)thread::hardware_concurrency(), 1);
+    }
+    noThreads = max(1, (int)min((long long)noThreads, (end - body) / MIN_CHUNK_SIZE));
+
+    vector<const char*> bounds(noThreads + 1, end);
+    bounds[0] = body;
+    for(int i=1;i<noThreads;i++)
+    {
+        const char* guess = body + (end - body) * i / noThreads;
+        bounds[i] = max(bounds[i-1], guess == body ? body : skipLine(guess - 1, end));
+    }
+
+    vector<vector<vector<int> > > partial(noThreads, vector<vector<int> >(noColumns));
+    vector<vector<long long> > partialWeights(noThreads);
+    vector<thread> workers;
+    for(int i=1;i<noThreads;i++)
+    {
+        workers.push_back(thread(parseChunk, bounds[i], bounds[i+1], end, ref(partial[i]), weighted ? &partialWeights[i] : nullptr));
+    }
+    parseChunk(bounds[0], bounds[1], end, partial[0], weighted ? &partialWeights[0] : nullptr);
+    for(auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    munmap(mapping, size);
+
+    if(noThreads == 1)
+    {
+        edges.columns.swap(partial[0]);
+        edges.weights.swap(partialWeights[0]);
+        return true;
+    }
+
+    for(int c=0;c<noColumns;c++)
+    {
+        size_t total = 0;
+        for(int i=0;i<noThreads;i++)
+        {
+            total += partial[i][c].size();
+        }
+
+        edges.columns[c].reserve(total);
+        for(int i=0;i<noThreads;i++)
+        {
+            edges.columns[c].insert(edges.columns[c].end(), partial[i][c].begin(), partial[i][c].end());
+            vector<int>().swap(partial[i][c]);
+        }
+    }
+
+    if(weighted)
+    {
+        size_t total = 0;
+        for(int i=0;i<noThreads;i++)
+        {
+            total += partialWeights[i].size();
+        }
+
+        edges.weights.reserve(total);
+        for(int i=0;i<noThreads;i++)
+        {
+            edges.weights.insert(edges.weights.end(), partialWeights[i].begin(), partialWeights[i].end());
+            vector<long long>().swap(partialWeights[i]);
+        }
+    }
+
+    return true;
+}
+
+bool readEdgeListHeader(const char* fileName, int noHeaderValues, vector<long long>& header)
+{
+    long long size;
+    const char* data = mapFile(fileName, size);
+    if(!data)
+    {
+        return false;
+    }
+
+    bool complete = parseHeader(data, data + size, noHeaderValues, header) != nullptr;
+    munmap((void*)data, size);
+    return complete;
+}
+
+bool streamEdgeList(const char* fileName, int noHeaderValues, int noColumns, int blockSize, vector<long long>& header,
+    const function<void(vector<vector<int> >& columns)>& visit)
+{
+    PERF_REGION("stream");
+    long long size;
+    const char* data = mapFile(fileName, size);
+    if(!data)
+    {
+        return false;
+    }
+    const char* end = data + size;
+
+    const char* p = parseHeader(data, end, noHeaderValues, header);
+    if(!p)
+    {
+        munmap((void*)data, size);
+        return false;
+    }
+
+    long long pageSize = sysconf(_SC_PAGESIZE), released = 0;
+    vector<vector<int> > columns(noColumns);
+    vector<long long> values(noColumns);
+    while(p < end)
+    {
+        for(int c=0;c<noColumns;c++)
+        {
+            columns[c].clear();
+        }
+
+        while(p < end && (int)columns[0].size() < blockSize)
+        {
+            bool complete;
+            p = parseLine(p, end, noColumns, values.data(), complete);
+            if(complete)
+            {
+                for(int c=0;c<noColumns;c++)
+                {
+                    columns[c].push_back(values[c]);
+                }
+            }
+        }
+
+        long long parsed = (p - data) / pageSize * pageSize;
+        if(parsed > released)
+        {
+            madvise((void*)(data + released), parsed - released, MADV_DONTNEED);
+            released = parsed;
+        }
+
+        if(!columns[0].empty())
+        {
+            visit(columns);
+        }
+    }
+
+    munmap((void*)data, size);
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef edge_loader_hpp
+#define edge_loader_hpp
+
+#include<vector>
+#include<functional>
+
+/**
+ * \brief Contents of a whitespace separated edge-list file.
+ *
+ * The first line which is not a comment is the header, and every following
+ * line holds one edge. Lines starting with '#' or '%' are treated as comments.
+ */
+struct EdgeList
+{
+    /**
+     * Numbers read from the header line.
+     */
+    std::vector<long long> header;
+
+    /**
+     * Columns of the edge lines, columns[c][i] being the c-th number on the i-th edge line.
+     */
+    std::vector<std::vector<int> > columns;
+
+    /**
+     * Weight of every edge line, the number after the columns, read only for weighted lists.
+     * Weights are kept in 64 bits, as capacities may not fit in an int.
+     */
+    std::vector<long long> weights;
+
+    /**
+     * \brief Returns the number of edges read.
+     */
+    int noEdges() const;
+};
+
+/**
+ * \brief Loads an edge-list file by memory-mapping it and parsing it with several threads.
+ *
+ * The file is split into chunks at line boundaries, and each chunk is parsed by its own
+ * thread directly from the mapping. Numbers beyond noColumns on an edge line are ignored,
+ * and lines with fewer numbers are skipped.
+ *
+ * Returns false if the file cannot be opened or its header is incomplete.
+ *
+ * @param fileName - path of the edge-list file
+ * @param noHeaderValues - number of values expected on the header line
+ * @param noColumns - number of values read into columns from every edge line
+ * @param edges - filled with the header, the columns and the weights of the file
+ * @param noThreads - number of threads used for parsing, 0 for all cores
+ * @param weighted - whether every edge line also holds a weight after the columns
+ */
+bool loadEdgeList(const char* fileName, int noHeaderValues, int noColumns, EdgeList& edges, int noThreads, bool weighted = false);
+
+/**
+ * \brief Reads only the header line of an edge-list file, and returns whether it is complete.
+ *
+ * @param fileName - path of the edge-list file
+ * @param noHeaderValues - number of values expected on the header line
+ * @param header - filled with the numbers read from the header line
+ */
+bool readEdgeListHeader(const char* fileName, int noHeaderValues, std::vector<long long>& header);
+
+/**
+ * \brief Reads an edge-list file in blocks of edges, for files too large to be held in memory.
+ *
+ * The file is memory-mapped and parsed on the calling thread, and the pages already parsed
+ * are released from the mapping, so only a block of edges is held at a time. visit is
+ * called with the columns of every block of at most blockSize edges, and may clear them.
+ *
+ * Returns false if the file cannot be opened or its header is incomplete.
+ *
+ * @param fileName - path of the edge-list file
+ * @param noHeaderValues - number of values expected on the header line
+ * @param noColumns - number of values read from every edge line
+ * @param blockSize - largest number of edges handed to visit at a time
+ * @param header - filled with the numbers read from the header line
+ * @param visit - called with the columns of every block of edges
+ */
+bool streamEdgeList(const char* fileName, int noHeaderValues, int noColumns, int blockSize, std::vector<long long>& header,
+    const std::function<void(std::vector<std::vector<int> >& columns)>& visit);
+
+#endif
@@ -0,0 +1,333 @@
+#include<vector>
+#include<string>
+#include<cstring>
+#include<cstdio>
+#include<algorithm>
+#include<climits>
+
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+#include "graph_snapshot.hpp"
+
+using namespace std;
+
+
+/**
+ * Magic bytes at the start of every snapshot.
+ */
+const char SNAPSHOT_MAGIC[8] = {'C', 'S', 'R', 'S', 'N', 'A', 'P', '2'};
+
+/**
+ * Maximum number of header-line values stored in a snapshot.
+ */
+const int MAX_HEADER_VALUES = 4;
+
+/**
+ * Extension appended to a text graph file name for its cached snapshot.
+ */
+const char SNAPSHOT_EXTENSION[] = ".csr";
+
+/**
+ * Fixed-size header at the start of every snapshot.
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    int kind;
+    int noHeaderValues;
+    long long header[MAX_HEADER_VALUES];
+    long long noRows;
+    long long noEdges;
+    long long noValues;
+};
+
+
+/**
+ * \brief Returns the size in bytes of every value of a snapshot of the given kind.
+ */
+static long long valueSize(SNAPSHOT_KIND kind)
+{
+    return kind == SNAPSHOT_FLOW ? sizeof(long long) : sizeof(int);
+}
+
+/**
+ * \brief Returns whether the CSR arrays of a mapped snapshot of the given kind are consistent
+ * with its counts, so that they can be used in place without bounds checks: at least the
+ * vertex and edge counts on the header line, offsets from 0 to the number of edges and never
+ * decreasing, targets within the vertices of the other end of the edges, and a value for
+ * every vertex or edge.
+ */
+static bool isConsistent(const SnapshotHeader* header, SNAPSHOT_KIND kind)
+{
+    if(header->noHeaderValues < 2 || header->noHeaderValues > MAX_HEADER_VALUES)
+    {
+        return false;
+    }
+
+    /*
+     * Every graph has a row for every vertex of the header line. A digraph may have more, as
+     * its rows also number the vertex ids of the edges beyond the count of the header line.
+     * The targets of a bipartite graph are the vertices of the second set.
+     */
+    long long noColumns = header->noRows;
+    if(kind == SNAPSHOT_DIGRAPH ? header->header[0] > header->noRows : header->header[0] != header->noRows)
+    {
+        return false;
+    }
+    if(kind == SNAPSHOT_BIPARTITE)
+    {
+        noColumns = header->header[1];
+    }
+
+    long long expectedValues = kind == SNAPSHOT_DIGRAPH ? header->noRows : kind == SNAPSHOT_FLOW ? header->noEdges : 0;
+    if(header->noValues != expectedValues)
+    {
+        return false;
+    }
+
+    const int* offsets = (const int*)((const char*)(header + 1) + valueSize(kind) * header->noValues);
+    const int* targets = offsets + header->noRows + 1;
+    if(offsets[0] != 0 || offsets[header->noRows] != header->noEdges)
+    {
+        return false;
+    }
+    for(long long v=0;v<header->noRows;v++)
+    {
+        if(offsets[v] > offsets[v+1])
+        {
+            return false;
+        }
+    }
+    for(long long i=0;i<header->noEdges;i++)
+    {
+        if(targets[i] < 0 || targets[i] >= noColumns)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+GraphSnapshot::GraphSnapshot()
+{
+    mapping = nullptr;
+    mappingSize = 0;
+    rowCount = edgeCount = valueCount = 0;
+    offsetArray = targetArray = nullptr;
+    valueArray = nullptr;
+}
+
+GraphSnapshot::~GraphSnapshot()
+{
+    close();
+}
+
+void GraphSnapshot::close()
+{
+    if(mapping)
+    {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+}
+
+bool GraphSnapshot::isSnapshot(const char* fileName)
+{
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+
+    FILE* file = fopen(fileName, "rb");
+    if(!file)
+    {
+        return false;
+    }
+    bool found = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && !memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic));
+    fclose(file);
+
+    return found;
+}
+
+bool GraphSnapshot::open(const char* fileName, SNAPSHOT_KIND kind)
+{
+    close();
+
+    int fd = ::open(fileName, O_RDONLY);
+    if(fd == -1)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) == -1 || info.st_size < (long long)sizeof(SnapshotHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    mappingSize = info.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        return false;
+    }
+
+    /*
+     * The counts are checked before the size is computed from them, so that it cannot overflow,
+     * and the arrays only once the size shows they are all mapped.
+     */
+    const SnapshotHeader* header = (const SnapshotHeader*)mapping;
+    bool validCounts = header->noRows >= 0 && header->noRows < INT_MAX && header->noEdges >= 0 &&
+        header->noEdges <= INT_MAX && header->noValues >= 0 && header->noValues <= INT_MAX;
+    long long expectedSize = validCounts ? sizeof(SnapshotHeader) + valueSize(kind) * header->noValues +
+        sizeof(int) * (header->noRows + 1 + header->noEdges) : -1;
+    if(memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) || header->kind != kind ||
+        expectedSize != mappingSize || !isConsistent(header, kind))
+    {
+        close();
+        return false;
+    }
+
+    headerValues.assign(header->header, header->header + header->noHeaderValues);
+    rowCount = header->noRows;
+    edgeCount = header->noEdges;
+    valueCount = header->noValues;
+
+    valueArray = header + 1;
+    offsetArray = (const int*)((const char*)valueArray + valueSize(kind) * valueCount);
+    targetArray = offsetArray + rowCount + 1;
+
+    return true;
+}
+
+template<class Value>
+bool GraphSnapshot::write(const char* fileName, SNAPSHOT_KIND kind, const vector<long long>& header,
+    int noRows, const int* offsets, const int* targets, long long noValues, const Value* values)
+{
+    if((long long)sizeof(Value) != valueSize(kind))
+    {
+        return false;
+    }
+
+    SnapshotHeader fileHeader;
+    memset(&fileHeader, 0, sizeof(fileHeader));
+    memcpy(fileHeader.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    fileHeader.kind = kind;
+    fileHeader.noHeaderValues = min((int)header.size(), MAX_HEADER_VALUES);
+    for(int i=0;i<fileHeader.noHeaderValues;i++)
+    {
+        fileHeader.header[i] = header[i];
+    }
+    fileHeader.noRows = noRows;
+    fileHeader.noEdges = offsets[noRows];
+    fileHeader.noValues = noValues;
+
+    /*
+     * Write to a temporary file first, so that a concurrent reader never
+     * maps a partially written snapshot.
+     */
+    string temporary = string(fileName) + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if(!file)
+    {
+        return false;
+    }
+
+    bool written = fwrite(&fileHeader, sizeof(fileHeader), 1, file) == 1;
+    written = written && fwrite(values, sizeof(Value), noValues, file) == (size_t)noValues;
+    written = written && fwrite(offsets, sizeof(int), noRows + 1, file) == (size_t)noRows + 1;
+    written = written && fwrite(targets, sizeof(int), fileHeader.noEdges, file) == (size_t)fileHeader.noEdges;
+    written = !fclose(file) && written;
+
+    if(!written || rename(temporary.c_str(), fileName))
+    {
+        remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * The values of digraph and bipartite snapshots are ints, and the capacities of flow networks
+ * long longs.
+ */
+template bool GraphSnapshot::write<int>(const char*, SNAPSHOT_KIND, const vector<long long>&, int, const int*, const int*,
+    long long, const int*);
+template bool GraphSnapshot::write<long long>(const char*, SNAPSHOT_KIND, const vector<long long>&, int, const int*,
+    const int*, long long, const long long*);
+
+const vector<long long>& GraphSnapshot::header()
+{
+    return headerValues;
+}
+
+int GraphSnapshot::noRows()
+{
+    return rowCount;
+}
+
+int GraphSnapshot::noEdges()
+{
+    return edgeCount;
+}
+
+long long GraphSnapshot::noValues()
+{
+    return valueCount;
+}
+
+const int* GraphSnapshot::offsets()
+{
+    return offsetArray;
+}
+
+const int* GraphSnapshot::targets()
+{
+    return targetArray;
+}
+
+const int* GraphSnapshot::values()
+{
+    return (const int*)valueArray;
+}
+
+const long long* GraphSnapshot::weights()
+{
+    return (const long long*)valueArray;
+}
+
+string snapshotPath(const char* fileName)
+{
+    return string(fileName) + SNAPSHOT_EXTENSION;
+}
+
+bool hasFreshSnapshot(const char* fileName)
+{
+    struct stat graphInfo, snapshotInfo;
+    if(stat(fileName, &graphInfo) == -1 || stat(snapshotPath(fileName).c_str(), &snapshotInfo) == -1)
+    {
+        return false;
+    }
+
+    return snapshotInfo.st_mtime >= graphInfo.st_mtime;
+}
+
+string findSnapshot(const char* fileName, bool cache)
+{
+    if(GraphSnapshot::isSnapshot(fileName))
+    {
+        return fileName;
+    }
+    if(cache && hasFreshSnapshot(fileName) && GraphSnapshot::isSnapshot(snapshotPath(fileName).c_str()))
+    {
+        return snapshotPath(fileName);
+    }
+
+    return "";
+}
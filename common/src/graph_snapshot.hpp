@@ -0,0 +1,183 @@
+#ifndef graph_snapshot_hpp
+#define graph_snapshot_hpp
+
+#include<vector>
+#include<string>
+
+/**
+ * \brief Enum representing the kind of graph stored in a snapshot.
+ *
+ *      SNAPSHOT_DIGRAPH - digraph, with the original vertex ids as values
+ *      SNAPSHOT_FLOW - flow network, with the edge capacities as 64-bit values
+ *      SNAPSHOT_BIPARTITE - bipartite graph indexed by left vertex, without values
+ *
+ */
+enum SNAPSHOT_KIND
+{
+    SNAPSHOT_DIGRAPH,
+    SNAPSHOT_FLOW,
+    SNAPSHOT_BIPARTITE
+};
+
+/**
+ * Class template for a binary CSR snapshot of a graph.
+ *
+ * The file holds a fixed-size header (magic, kind, the header line of the original
+ * text file, vertex, edge and value counts) followed by the per-vertex or per-edge values,
+ * the CSR offsets and the targets. The values are 64-bit integers for flow networks and
+ * 32-bit ones otherwise, and come first so that they are aligned, and the offsets and
+ * targets are 32-bit integers. Snapshots are memory-mapped when read, and the arrays are
+ * used in place.
+ */
+class GraphSnapshot
+{
+    private:
+        /**
+         * Start of the memory mapping, or nullptr if no snapshot is open.
+         */
+        void* mapping;
+
+        /**
+         * Size of the memory mapping in bytes.
+         */
+        long long mappingSize;
+
+        /**
+         * Numbers on the header line of the original text file.
+         */
+        std::vector<long long> headerValues;
+
+        /**
+         * Number of rows of the CSR, number of edges and number of values.
+         */
+        long long rowCount, edgeCount, valueCount;
+
+        /**
+         * Arrays stored in the mapping.
+         */
+        const int* offsetArray;
+        const int* targetArray;
+        const void* valueArray;
+
+        /**
+         * \brief Unmaps the snapshot, if one is open.
+         */
+        void close();
+
+    public:
+        /**
+         * \brief Creates an empty snapshot object.
+         */
+        GraphSnapshot();
+
+        /**
+         * \brief Unmaps the snapshot.
+         */
+        ~GraphSnapshot();
+
+        GraphSnapshot(const GraphSnapshot&) = delete;
+        GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+        /**
+         * \brief Returns whether the file starts with the snapshot magic.
+         *
+         * @param fileName - path of the file to check
+         */
+        static bool isSnapshot(const char* fileName);
+
+        /**
+         * \brief Memory-maps a snapshot, and returns whether it is a valid snapshot of the given kind.
+         *
+         * The CSR arrays are checked once here, offsets running from 0 to the number of edges
+         * without decreasing, and every target naming a vertex, so the readers index them
+         * without further checks.
+         *
+         * @param fileName - path of the snapshot
+         * @param kind - kind of graph expected in the snapshot
+         */
+        bool open(const char* fileName, SNAPSHOT_KIND kind);
+
+        /**
+         * \brief Writes a snapshot, and returns whether it succeeded.
+         *
+         * Value is int for digraphs and bipartite graphs, and long long for flow networks.
+         *
+         * @param fileName - path of the snapshot
+         * @param kind - kind of graph stored
+         * @param header - numbers on the header line of the original text file
+         * @param noRows - number of rows of the CSR
+         * @param offsets - CSR offsets, noRows + 1 entries
+         * @param targets - CSR targets, offsets[noRows] entries
+         * @param noValues - number of values
+         * @param values - per-vertex or per-edge values
+         */
+        template<class Value>
+        static bool write(const char* fileName, SNAPSHOT_KIND kind, const std::vector<long long>& header,
+            int noRows, const int* offsets, const int* targets, long long noValues, const Value* values);
+
+        /**
+         * \brief Returns the numbers on the header line of the original text file.
+         */
+        const std::vector<long long>& header();
+
+        /**
+         * \brief Returns the number of rows of the CSR.
+         */
+        int noRows();
+
+        /**
+         * \brief Returns the number of edges.
+         */
+        int noEdges();
+
+        /**
+         * \brief Returns the number of values.
+         */
+        long long noValues();
+
+        /**
+         * \brief Returns the CSR offsets.
+         */
+        const int* offsets();
+
+        /**
+         * \brief Returns the CSR targets.
+         */
+        const int* targets();
+
+        /**
+         * \brief Returns the per-vertex values of a digraph snapshot.
+         */
+        const int* values();
+
+        /**
+         * \brief Returns the edge capacities of a flow network snapshot.
+         */
+        const long long* weights();
+};
+
+/**
+ * \brief Returns the path of the snapshot cached for a text graph file.
+ *
+ * @param fileName - path of the text graph file
+ */
+std::string snapshotPath(const char* fileName);
+
+/**
+ * \brief Returns whether a cached snapshot exists and is newer than the text graph file.
+ *
+ * @param fileName - path of the text graph file
+ */
+bool hasFreshSnapshot(const char* fileName);
+
+/**
+ * \brief Returns the snapshot to be loaded for a graph file: the file itself if it is a
+ * snapshot, its cached snapshot if caching is enabled and the cache is fresh and of the
+ * current format, or an empty string if the text file has to be parsed.
+ *
+ * @param fileName - path of the graph file
+ * @param cache - whether cached snapshots are used
+ */
+std::string findSnapshot(const char* fileName, bool cache);
+
+#endif
@@ -0,0 +1,210 @@
+#include<string>
+#include<vector>
+#include<chrono>
+#include<iostream>
+#include<fstream>
+#include<iomanip>
+#include<cstring>
+#include<cerrno>
+#include<mutex>
+
+#include<unistd.h>
+#include<sys/ioctl.h>
+#include<sys/syscall.h>
+#include<linux/perf_event.h>
+
+#include "perf_counters.hpp"
+
+using namespace std;
+
+/**
+ * Macro short-hand for printing a decimal x with a precision of y.
+ */
+#define FIXED_FLOAT(x, y) fixed<<setprecision(y)<<(x)
+
+
+/**
+ * Type and config of every event, in the order of PERF_EVENT.
+ */
+const unsigned EVENT_TYPES[NO_PERF_EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+const unsigned long long EVENT_CONFIGS[NO_PERF_EVENTS] =
+    {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+const char* const EVENT_NAMES[NO_PERF_EVENTS] = {"cycles", "instructions", "LLC misses", "branch misses"};
+
+
+
+PerfCounters::PerfCounters()
+{
+    for(int event=0;event<NO_PERF_EVENTS;event++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = EVENT_TYPES[event];
+        attr.config = EVENT_CONFIGS[event];
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fds[event] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if(fds[event] == -1 && unavailableReason.empty())
+        {
+            unavailableReason = string(EVENT_NAMES[event]) + " - " + strerror(errno);
+            if(errno == EACCES || errno == EPERM)
+            {
+                unavailableReason += " (see /proc/sys/kernel/perf_event_paranoid)";
+            }
+        }
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for(int event=0;event<NO_PERF_EVENTS;event++)
+    {
+        if(fds[event] != -1)
+        {
+            close(fds[event]);
+        }
+    }
+}
+
+PerfCounters& PerfCounters::instance()
+{
+    static PerfCounters counters;
+    return counters;
+}
+
+bool PerfCounters::available(PERF_EVENT event)
+{
+    return fds[event] != -1;
+}
+
+void PerfCounters::read(long long* values)
+{
+    for(int event=0;event<NO_PERF_EVENTS;event++)
+    {
+        /*
+         * value, time enabled and time running, the last two differing while the
+         * kernel multiplexes more events than there are hardware counters.
+         */
+        unsigned long long data[3];
+        values[event] = 0;
+        if(fds[event] != -1 && ::read(fds[event], data, sizeof(data)) == sizeof(data) && data[2])
+        {
+            values[event] = data[2] < data[1] ? (long long)((double)data[0] * data[1] / data[2]) : data[0];
+        }
+    }
+}
+
+void PerfCounters::addRegion(const string& name, const long long* begin, const long long* end, double seconds)
+{
+    lock_guard<mutex> guard(regionsLock);
+    size_t i = 0;
+    while(i < regions.size() && regions[i].name != name)
+    {
+        i++;
+    }
+    if(i == regions.size())
+    {
+        regions.push_back(PerfRegionTotals());
+        regions[i].name = name;
+        regions[i].calls = 0;
+        regions[i].seconds = 0;
+        memset(regions[i].values, 0, sizeof(regions[i].values));
+    }
+
+    regions[i].calls++;
+    regions[i].seconds += seconds;
+    for(int event=0;event<NO_PERF_EVENTS;event++)
+    {
+        regions[i].values[event] += end[event] - begin[event];
+    }
+}
+
+void PerfCounters::report(ostream& out)
+{
+    lock_guard<mutex> guard(regionsLock);
+    out<<"Performance Counters:"<<endl;
+    if(!unavailableReason.empty())
+    {
+        out<<"\tUnavailable - "<<unavailableReason<<endl;
+    }
+
+    for(auto& region : regions)
+    {
+        out<<"\t"<<region.name<<" - "<<region.calls<<(region.calls == 1 ? " call, " : " calls, ")
+            <<FIXED_FLOAT(region.seconds, 6)<<" seconds";
+        for(int event=0;event<NO_PERF_EVENTS;event++)
+        {
+            if(available((PERF_EVENT)event))
+            {
+                out<<", "<<region.values[event]<<" "<<EVENT_NAMES[event];
+            }
+        }
+        if(available(PERF_CYCLES) && available(PERF_INSTRUCTIONS) && region.values[PERF_CYCLES])
+        {
+            out<<", "<<FIXED_FLOAT((double)region.values[PERF_INSTRUCTIONS] / region.values[PERF_CYCLES], 2)<<" IPC";
+        }
+        out<<endl;
+    }
+    out<<endl;
+}
+
+void PerfCounters::writeResults(const char* fileName, const char* graphName)
+{
+    ofstream resultsFile(fileName, ios_base::app);
+    if(!resultsFile.is_open())
+    {
+        return;
+    }
+
+    lock_guard<mutex> guard(regionsLock);
+    for(auto& region : regions)
+    {
+        resultsFile<<graphName<<" "<<region.name<<" "<<region.calls<<" "<<FIXED_FLOAT(region.seconds, 6);
+        for(int event=0;event<NO_PERF_EVENTS;event++)
+        {
+            resultsFile<<" ";
+            if(available((PERF_EVENT)event))
+            {
+                resultsFile<<region.values[event];
+            }
+            else
+            {
+                resultsFile<<"-";
+            }
+        }
+        resultsFile<<endl;
+    }
+}
+
+PerfRegion::PerfRegion(const string& name) : name(name)
+{
+    PerfCounters::instance().read(begin);
+    start = wallTime();
+}
+
+PerfRegion::~PerfRegion()
+{
+    double stop = wallTime();
+    long long end[NO_PERF_EVENTS];
+    PerfCounters::instance().read(end);
+    PerfCounters::instance().addRegion(name, begin, end, stop - start);
+}
+
+double wallTime()
+{
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void reportPerfCounters(const char* resultsFile, const char* graphName)
+{
+    PerfCounters& counters = PerfCounters::instance();
+    counters.report(cout);
+    if(resultsFile)
+    {
+        counters.writeResults((string(resultsFile) + ".perf").c_str(), graphName);
+    }
+}
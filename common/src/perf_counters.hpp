@@ -0,0 +1,202 @@
+#ifndef perf_counters_hpp
+#define perf_counters_hpp
+
+#include<string>
+#include<vector>
+#include<ostream>
+#include<mutex>
+
+/**
+ * \brief Enum representing the hardware events counted in every region.
+ *
+ *      PERF_CYCLES - CPU cycles
+ *      PERF_INSTRUCTIONS - retired instructions
+ *      PERF_LLC_MISSES - last-level cache misses
+ *      PERF_BRANCH_MISSES - mispredicted branches
+ *
+ */
+enum PERF_EVENT
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    NO_PERF_EVENTS
+};
+
+/**
+ * \brief Counts and time accumulated over every entry of a named region.
+ */
+struct PerfRegionTotals
+{
+    std::string name;
+    long long calls;
+    double seconds;
+    long long values[NO_PERF_EVENTS];
+};
+
+/**
+ * Class template for the process-wide set of hardware performance counters.
+ *
+ * The counters are opened with perf_event_open on first use, counting the calling thread
+ * and every thread it creates afterwards, so they have to be opened before any thread pool
+ * is started. Counters the kernel refuses (no permission, no PMU as in most virtual
+ * machines, or an unsupported event) are left closed and reported as unavailable, and
+ * regions are then only timed.
+ *
+ * The counters count the whole process rather than the thread in a region, so nested regions
+ * are inclusive, and regions open at the same time on several threads, as when a batch is
+ * solved on a thread pool, overlap: each of them also counts the work of the others. The
+ * counts and times of a region entered several times are summed, and regions may be left
+ * on any thread.
+ */
+class PerfCounters
+{
+    private:
+        /**
+         * File descriptor of every counter, -1 if it is unavailable.
+         */
+        int fds[NO_PERF_EVENTS];
+
+        /**
+         * Reason the first unavailable counter could not be opened.
+         */
+        std::string unavailableReason;
+
+        /**
+         * Totals of every region, in the order in which the regions were first entered.
+         */
+        std::vector<PerfRegionTotals> regions;
+
+        /**
+         * Lock guarding regions, which are left concurrently by the threads of a pool.
+         */
+        std::mutex regionsLock;
+
+        /**
+         * \brief Opens the counters.
+         */
+        PerfCounters();
+
+    public:
+        /**
+         * \brief Closes the counters.
+         */
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /**
+         * \brief Returns the counters of the process, opening them on the first call.
+         */
+        static PerfCounters& instance();
+
+        /**
+         * \brief Returns whether an event is being counted.
+         *
+         * @param event - event to be checked
+         */
+        bool available(PERF_EVENT event);
+
+        /**
+         * \brief Reads the current value of every counter, scaled up if the kernel had to
+         * multiplex it. Unavailable counters read as 0.
+         *
+         * @param values - filled with NO_PERF_EVENTS values
+         */
+        void read(long long* values);
+
+        /**
+         * \brief Adds one entry of a region to its totals.
+         *
+         * @param name - name of the region
+         * @param begin - counter values read when the region was entered
+         * @param end - counter values read when the region was left
+         * @param seconds - wall-clock time spent in the region
+         */
+        void addRegion(const std::string& name, const long long* begin, const long long* end, double seconds);
+
+        /**
+         * \brief Prints the totals of every region in the format of the program output.
+         *
+         * @param out - stream the totals are printed to
+         */
+        void report(std::ostream& out);
+
+        /**
+         * \brief Appends a line "graphName region calls seconds cycles instructions llcMisses
+         * branchMisses" for every region to a file, with "-" for unavailable counters.
+         *
+         * @param fileName - path of the file
+         * @param graphName - name of the graph the regions were measured on
+         */
+        void writeResults(const char* fileName, const char* graphName);
+};
+
+/**
+ * Class template for a named region measured from its construction to its destruction.
+ */
+class PerfRegion
+{
+    private:
+        std::string name;
+        long long begin[NO_PERF_EVENTS];
+        double start;
+
+    public:
+        /**
+         * \brief Enters a region.
+         *
+         * @param name - name of the region
+         */
+        PerfRegion(const std::string& name);
+
+        /**
+         * \brief Leaves the region, adding it to the totals of its name.
+         */
+        ~PerfRegion();
+};
+
+/**
+ * The instrumentation is compiled in only if PERF_COUNTERS is defined (make PERF_COUNTERS=1),
+ * otherwise the macros expand to nothing and their arguments are not evaluated.
+ *
+ *      PERF_START() - opens the counters, before any thread is created
+ *      PERF_REGION(name) - measures the rest of the enclosing block as the region name
+ *      PERF_REPORT(resultsFile, graphName) - prints the regions, and appends them to
+ *          resultsFile.perf if resultsFile is not nullptr
+ */
+#ifdef PERF_COUNTERS
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_START() PerfCounters::instance()
+#define PERF_REGION(name) PerfRegion PERF_CONCAT(perfRegion, __LINE__)(name)
+#define PERF_REPORT(resultsFile, graphName) reportPerfCounters(resultsFile, graphName)
+#else
+#define PERF_START()
+#define PERF_REGION(name)
+#define PERF_REPORT(resultsFile, graphName)
+#endif
+
+/**
+ * \brief Returns the wall-clock time in seconds since an arbitrary point.
+ *
+ * Every processing, ordering and query time printed or appended to a results file is the
+ * difference of two calls. It is wall-clock rather than the CPU time of clock(), which sums
+ * over every thread of the parallel engines and of a batch solved concurrently, and leaves
+ * out the waits of the semi-external passes on the disk, so times are comparable across
+ * engines and modes.
+ */
+double wallTime();
+
+/**
+ * \brief Prints the regions measured, and appends them to resultsFile.perf if resultsFile
+ * is not nullptr.
+ *
+ * @param resultsFile - results file of the program, or nullptr
+ * @param graphName - name of the graph the regions were measured on
+ */
+void reportPerfCounters(const char* resultsFile, const char* graphName);
+
+#endif
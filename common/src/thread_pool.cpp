@@ -0,0 +1,163 @@
+#include<vector>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<atomic>
+#include<memory>
+#include<functional>
+#include<condition_variable>
+#include<algorithm>
+
+#include "thread_pool.hpp"
+
+using namespace std;
+
+
+/**
+ * Number of the current thread within the pool executing it.
+ */
+static thread_local int currentThread = 0;
+
+
+ThreadPool::ThreadPool(int noThreads) : noQueued(0), stopping(false)
+{
+    noThreads = max(noThreads, 1);
+    for(int i=0;i<noThreads;i++)
+    {
+        queues.push_back(unique_ptr<TaskQueue>(new TaskQueue()));
+    }
+    for(int i=1;i<noThreads;i++)
+    {
+        workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for(auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int ThreadPool::size()
+{
+    return queues.size();
+}
+
+int ThreadPool::threadIndex()
+{
+    return currentThread;
+}
+
+void ThreadPool::submit(TaskGroup& group, function<void()> task)
+{
+    group.pending++;
+
+    TaskQueue& queue = *queues[currentThread < size() ? currentThread : 0];
+    {
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks.push_back(Task(&group, move(task)));
+    }
+
+    {
+        lock_guard<mutex> guard(sleepLock);
+        noQueued++;
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::runOne(int self)
+{
+    Task task;
+    bool found = false;
+
+    for(int i=0;i<size() && !found;i++)
+    {
+        TaskQueue& queue = *queues[(self + i) % size()];
+        lock_guard<mutex> guard(queue.lock);
+        if(queue.tasks.empty())
+        {
+            continue;
+        }
+
+        if(i == 0)
+        {
+            task = move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        found = true;
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    noQueued--;
+    task.second();
+    task.first->pending--;
+    return true;
+}
+
+void ThreadPool::workerLoop(int self)
+{
+    currentThread = self;
+    while(true)
+    {
+        if(runOne(self))
+        {
+            continue;
+        }
+
+        unique_lock<mutex> guard(sleepLock);
+        wakeUp.wait(guard, [this] { return noQueued > 0 || stopping; });
+        if(stopping)
+        {
+            return;
+        }
+    }
+}
+
+void ThreadPool::wait(TaskGroup& group)
+{
+    while(group.pending > 0)
+    {
+        if(!runOne(currentThread < size() ? currentThread : 0))
+        {
+            this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(int begin, int end, int grain, const function<void(int, int)>& body)
+{
+    grain = max(grain, 1);
+    if(size() == 1 || end - begin <= grain)
+    {
+        if(begin < end)
+        {
+            body(begin, end);
+        }
+        return;
+    }
+
+    TaskGroup group;
+    for(int chunk=begin;chunk<end;chunk+=grain)
+    {
+        int chunkEnd = min(end, chunk + grain);
+        submit(group, [&body, chunk, chunkEnd] { body(chunk, chunkEnd); });
+    }
+    wait(group);
+}
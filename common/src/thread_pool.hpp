@@ -0,0 +1,143 @@
+#ifndef thread_pool_hpp
+#define thread_pool_hpp
+
+#include<vector>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<atomic>
+#include<memory>
+#include<functional>
+#include<condition_variable>
+
+/**
+ * \brief Group of tasks submitted to a ThreadPool, which can be waited upon together.
+ */
+struct TaskGroup
+{
+    /**
+     * Number of tasks of the group that have not finished executing yet.
+     */
+    std::atomic<int> pending;
+
+    TaskGroup() : pending(0) {}
+};
+
+/**
+ * Class template for a work-stealing thread pool.
+ *
+ * Every thread owns a double-ended queue of tasks. A thread pushes and pops tasks
+ * at the back of its own queue, and steals from the front of the other queues when
+ * its own queue is empty. The thread that created the pool acts as thread 0, and
+ * executes tasks while it waits on a TaskGroup.
+ */
+class ThreadPool
+{
+    private:
+        /**
+         * A task along with the group it belongs to.
+         */
+        typedef std::pair<TaskGroup*, std::function<void()> > Task;
+
+        /**
+         * Task queue owned by one of the threads.
+         */
+        struct TaskQueue
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        /**
+         * Task queues for every thread, indexed by the thread number.
+         */
+        std::vector<std::unique_ptr<TaskQueue> > queues;
+
+        /**
+         * Worker threads, excluding the thread that created the pool.
+         */
+        std::vector<std::thread> workers;
+
+        /**
+         * Number of tasks waiting in any of the queues.
+         */
+        std::atomic<int> noQueued;
+
+        /**
+         * Whether the pool is being destroyed.
+         */
+        std::atomic<bool> stopping;
+
+        /**
+         * Mutex and condition variable used by idle workers to sleep.
+         */
+        std::mutex sleepLock;
+        std::condition_variable wakeUp;
+
+        /**
+         * \brief Main loop of a worker thread.
+         *
+         * @param self - number of the worker thread
+         */
+        void workerLoop(int self);
+
+        /**
+         * \brief Runs one task from the thread's own queue, or one stolen from another
+         * queue, and returns whether a task was found.
+         *
+         * @param self - number of the thread looking for work
+         */
+        bool runOne(int self);
+
+    public:
+        /**
+         * \brief Creates the thread pool.
+         *
+         * @param noThreads - total number of threads, including the calling thread
+         */
+        ThreadPool(int noThreads);
+
+        /**
+         * \brief Stops and joins the worker threads.
+         */
+        ~ThreadPool();
+
+        /**
+         * \brief Returns the total number of threads, including the calling thread.
+         */
+        int size();
+
+        /**
+         * \brief Returns the number of the calling thread within the pool executing it,
+         * or 0 for a thread not owned by a pool.
+         */
+        static int threadIndex();
+
+        /**
+         * \brief Adds a task to the queue of the calling thread.
+         *
+         * @param group - group to which the task belongs
+         * @param task - function to be executed
+         */
+        void submit(TaskGroup& group, std::function<void()> task);
+
+        /**
+         * \brief Executes tasks until every task in the group has finished.
+         *
+         * @param group - group of tasks to wait for
+         */
+        void wait(TaskGroup& group);
+
+        /**
+         * \brief Splits the range [begin, end) into chunks of at most grain elements,
+         * runs body on every chunk in parallel and waits for all of them.
+         *
+         * @param begin - first index of the range
+         * @param end - one past the last index of the range
+         * @param grain - maximum number of indices handed to one task
+         * @param body - function called with the bounds of every chunk
+         */
+        void parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body);
+};
+
+#endif
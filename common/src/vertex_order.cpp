@@ -0,0 +1,326 @@
+#include<vector>
+#include<algorithm>
+#include<cstring>
+#include<cmath>
+
+#include "vertex_order.hpp"
+
+using namespace std;
+
+
+/**
+ * Number of most recently placed vertices whose neighbourhoods are scored by Gorder.
+ */
+const int GORDER_WINDOW = 5;
+
+
+bool parseVertexOrder(const char* name, ORDER_TYPE& order)
+{
+    const char* names[] = {"none", "degree", "rcm", "gorder"};
+    const ORDER_TYPE orders[] = {ORDER_NONE, ORDER_DEGREE, ORDER_RCM, ORDER_GORDER};
+    for(int i=0;i<4;i++)
+    {
+        if(!strcmp(name, names[i]))
+        {
+            order = orders[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void buildEdgeCSR(int noVertices, const vector<int>& sources, const vector<int>& targets, int base,
+    vector<int>& offsets, vector<int>& csrTargets)
+{
+    offsets.assign(noVertices + 1, 0);
+    for(auto x : sources)
+    {
+        offsets[x - base + 1]++;
+    }
+    for(int x=0;x<noVertices;x++)
+    {
+        offsets[x+1] += offsets[x];
+    }
+
+    csrTargets.resize(sources.size());
+    vector<int> position(offsets.begin(), offsets.end() - 1);
+    for(size_t i=0;i<sources.size();i++)
+    {
+        csrTargets[position[sources[i] - base]++] = targets[i] - base;
+    }
+}
+
+/**
+ * \brief Builds the CSR of the in-edges of a graph from the CSR of its out-edges.
+ */
+static void buildReverse(int noVertices, const int* offsets, const int* targets,
+    vector<int>& reverseOffsets, vector<int>& reverseTargets)
+{
+    reverseOffsets.assign(noVertices + 1, 0);
+    for(int i=0;i<offsets[noVertices];i++)
+    {
+        reverseOffsets[targets[i]+1]++;
+    }
+    for(int y=0;y<noVertices;y++)
+    {
+        reverseOffsets[y+1] += reverseOffsets[y];
+    }
+
+    reverseTargets.resize(offsets[noVertices]);
+    vector<int> position(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for(int x=0;x<noVertices;x++)
+    {
+        for(int i=offsets[x];i<offsets[x+1];i++)
+        {
+            reverseTargets[position[targets[i]]++] = x;
+        }
+    }
+}
+
+/**
+ * \brief Orders the vertices by decreasing total degree, ties keeping their relative order.
+ */
+static void degreeOrder(int noVertices, const int* offsets, const int* reverseOffsets, vector<int>& sequence)
+{
+    vector<int> degree(noVertices);
+    int maxDegree = 0;
+    for(int v=0;v<noVertices;v++)
+    {
+        degree[v] = offsets[v+1] - offsets[v] + reverseOffsets[v+1] - reverseOffsets[v];
+        maxDegree = max(maxDegree, degree[v]);
+    }
+
+    vector<int> bucket(maxDegree + 2, 0);
+    for(int v=0;v<noVertices;v++)
+    {
+        bucket[maxDegree - degree[v] + 1]++;
+    }
+    for(int d=0;d<=maxDegree;d++)
+    {
+        bucket[d+1] += bucket[d];
+    }
+
+    sequence.resize(noVertices);
+    for(int v=0;v<noVertices;v++)
+    {
+        sequence[bucket[maxDegree - degree[v]]++] = v;
+    }
+}
+
+/**
+ * \brief Orders the vertices in reverse Cuthill-McKee order, treating every edge as undirected.
+ *
+ * Every connected component is searched breadth-first from one of its vertices of smallest
+ * degree, the neighbours of a vertex being queued by increasing degree, and the whole
+ * sequence is reversed at the end.
+ */
+static void rcmOrder(int noVertices, const int* offsets, const int* targets,
+    const int* reverseOffsets, const int* reverseTargets, vector<int>& sequence)
+{
+    auto degree = [&](int v) { return offsets[v+1] - offsets[v] + reverseOffsets[v+1] - reverseOffsets[v]; };
+
+    vector<int> byDegree(noVertices);
+    for(int v=0;v<noVertices;v++)
+    {
+        byDegree[v] = v;
+    }
+    stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree(a) < degree(b); });
+
+    vector<char> queued(noVertices, 0);
+    vector<int> neighbours;
+    sequence.clear();
+    sequence.reserve(noVertices);
+    for(auto start : byDegree)
+    {
+        if(queued[start])
+        {
+            continue;
+        }
+
+        queued[start] = 1;
+        sequence.push_back(start);
+        for(size_t next=sequence.size()-1;next<sequence.size();next++)
+        {
+            int v = sequence[next];
+            neighbours.clear();
+            for(int i=offsets[v];i<offsets[v+1];i++)
+            {
+                if(!queued[targets[i]])
+                {
+                    queued[targets[i]] = 1;
+                    neighbours.push_back(targets[i]);
+                }
+            }
+            for(int i=reverseOffsets[v];i<reverseOffsets[v+1];i++)
+            {
+                if(!queued[reverseTargets[i]])
+                {
+                    queued[reverseTargets[i]] = 1;
+                    neighbours.push_back(reverseTargets[i]);
+                }
+            }
+
+            stable_sort(neighbours.begin(), neighbours.end(), [&](int a, int b) { return degree(a) < degree(b); });
+            sequence.insert(sequence.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    reverse(sequence.begin(), sequence.end());
+}
+
+/**
+ * \brief Orders the vertices with the greedy Gorder heuristic of Wei et al.
+ *
+ * Vertices are placed one at a time. The next vertex is the unplaced one with the highest
+ * score against the last GORDER_WINDOW placed vertices, where a vertex scores one for every
+ * edge to or from a vertex of the window, and one for every in-neighbour it shares with a
+ * vertex of the window. In-neighbours with more than sqrt(V) out-edges are not counted as
+ * shared, as in the original implementation. Scores only ever change by one, so they are
+ * kept in a bucket list with the current maximum tracked.
+ */
+static void gorderOrder(int noVertices, const int* offsets, const int* targets,
+    const int* reverseOffsets, const int* reverseTargets, vector<int>& sequence)
+{
+    int hubDegree = max(1, (int)sqrt((double)noVertices));
+
+    vector<int> score(noVertices, 0), prev(noVertices), next(noVertices);
+    vector<int> head(1, -1);
+    vector<char> placed(noVertices, 0);
+    int maxScore = 0;
+
+    auto unlink = [&](int v)
+    {
+        if(prev[v] != -1)
+        {
+            next[prev[v]] = next[v];
+        }
+        else
+        {
+            head[score[v]] = next[v];
+        }
+        if(next[v] != -1)
+        {
+            prev[next[v]] = prev[v];
+        }
+    };
+    auto link = [&](int v)
+    {
+        if(score[v] >= (int)head.size())
+        {
+            head.resize(score[v] + 1, -1);
+        }
+        prev[v] = -1;
+        next[v] = head[score[v]];
+        if(next[v] != -1)
+        {
+            prev[next[v]] = v;
+        }
+        head[score[v]] = v;
+    };
+    auto change = [&](int v, int delta)
+    {
+        if(placed[v])
+        {
+            return;
+        }
+        unlink(v);
+        score[v] += delta;
+        link(v);
+        maxScore = max(maxScore, score[v]);
+    };
+    auto update = [&](int v, int delta)
+    {
+        for(int i=offsets[v];i<offsets[v+1];i++)
+        {
+            change(targets[i], delta);
+        }
+        for(int i=reverseOffsets[v];i<reverseOffsets[v+1];i++)
+        {
+            int parent = reverseTargets[i];
+            change(parent, delta);
+            if(offsets[parent+1] - offsets[parent] <= hubDegree)
+            {
+                for(int j=offsets[parent];j<offsets[parent+1];j++)
+                {
+                    change(targets[j], delta);
+                }
+            }
+        }
+    };
+
+    /*
+     * Vertices are linked in reverse so that ties are broken by the smallest id, and the
+     * vertex with most in-edges is placed first.
+     */
+    for(int v=noVertices-1;v>=0;v--)
+    {
+        link(v);
+    }
+    int first = 0;
+    for(int u=0;u<noVertices;u++)
+    {
+        if(reverseOffsets[u+1] - reverseOffsets[u] > reverseOffsets[first+1] - reverseOffsets[first])
+        {
+            first = u;
+        }
+    }
+
+    sequence.clear();
+    sequence.reserve(noVertices);
+    int v = first;
+    while(noVertices)
+    {
+        unlink(v);
+        placed[v] = 1;
+        sequence.push_back(v);
+        update(v, 1);
+        if(sequence.size() > GORDER_WINDOW)
+        {
+            update(sequence[sequence.size() - GORDER_WINDOW - 1], -1);
+        }
+        if(sequence.size() == (size_t)noVertices)
+        {
+            break;
+        }
+
+        while(head[maxScore] == -1)
+        {
+            maxScore--;
+        }
+        v = head[maxScore];
+    }
+}
+
+void computeVertexOrder(ORDER_TYPE order, int noVertices, const int* offsets, const int* targets, vector<int>& newId)
+{
+    newId.resize(noVertices);
+    if(order == ORDER_NONE)
+    {
+        for(int v=0;v<noVertices;v++)
+        {
+            newId[v] = v;
+        }
+        return;
+    }
+
+    vector<int> reverseOffsets, reverseTargets, sequence;
+    buildReverse(noVertices, offsets, targets, reverseOffsets, reverseTargets);
+
+    if(order == ORDER_DEGREE)
+    {
+        degreeOrder(noVertices, offsets, reverseOffsets.data(), sequence);
+    }
+    else if(order == ORDER_RCM)
+    {
+        rcmOrder(noVertices, offsets, targets, reverseOffsets.data(), reverseTargets.data(), sequence);
+    }
+    else
+    {
+        gorderOrder(noVertices, offsets, targets, reverseOffsets.data(), reverseTargets.data(), sequence);
+    }
+
+    for(int position=0;position<noVertices;position++)
+    {
+        newId[sequence[position]] = position;
+    }
+}
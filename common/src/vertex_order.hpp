@@ -0,0 +1,57 @@
+#ifndef vertex_order_hpp
+#define vertex_order_hpp
+
+#include<vector>
+
+/**
+ * \brief Enum representing the order in which the vertices of a graph are relabelled.
+ *
+ *      ORDER_NONE - vertices keep their ids
+ *      ORDER_DEGREE - vertices sorted by decreasing total degree
+ *      ORDER_RCM - reverse Cuthill-McKee order of the underlying undirected graph
+ *      ORDER_GORDER - greedy Gorder of Wei et al., placing vertices that share neighbours close together
+ *
+ */
+enum ORDER_TYPE
+{
+    ORDER_NONE,
+    ORDER_DEGREE,
+    ORDER_RCM,
+    ORDER_GORDER
+};
+
+/**
+ * \brief Parses the name of a vertex order (none, degree, rcm or gorder), and returns
+ * whether it is known.
+ *
+ * @param name - name of the order
+ * @param order - set to the order named
+ */
+bool parseVertexOrder(const char* name, ORDER_TYPE& order);
+
+/**
+ * \brief Computes a locality-improving relabelling of the vertices of a directed graph.
+ *
+ * @param order - order to compute
+ * @param noVertices - number of vertices of the graph
+ * @param offsets - CSR offsets of the out-edges, noVertices + 1 entries
+ * @param targets - CSR targets of the out-edges
+ * @param newId - filled with the new id of every vertex, a permutation of 0 .. noVertices - 1
+ */
+void computeVertexOrder(ORDER_TYPE order, int noVertices, const int* offsets, const int* targets, std::vector<int>& newId);
+
+/**
+ * \brief Builds the CSR adjacency of a list of edges, keeping the order of the edges
+ * leaving every vertex.
+ *
+ * @param noVertices - number of vertices of the graph
+ * @param sources - sources of the edges
+ * @param targets - destinations of the edges
+ * @param base - id of the first vertex in sources and targets
+ * @param offsets - filled with the CSR offsets, noVertices + 1 entries
+ * @param csrTargets - filled with the CSR targets, shifted by base
+ */
+void buildEdgeCSR(int noVertices, const std::vector<int>& sources, const std::vector<int>& targets, int base,
+    std::vector<int>& offsets, std::vector<int>& csrTargets);
+
+#endif
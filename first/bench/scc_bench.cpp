@@ -0,0 +1,248 @@
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<cstring>
+#include<cstdlib>
+#include<vector>
+#include<thread>
+#include<algorithm>
+
+#include "scc.hpp"
+#include "edge_loader.hpp"
+#include "vertex_map.hpp"
+#include "vertex_order.hpp"
+#include "graph_generators.hpp"
+#include "benchmark.hpp"
+
+using namespace std;
+
+
+/**
+ * Names of the engines, in the order of ALG_TYPE.
+ */
+const char* const ENGINE_NAMES[] = {"dfs", "dcsc", "tarjan", "pdcsc", "color"};
+const int NO_ENGINES = 5;
+
+
+static void displayBenchError(string errorMsg)
+{
+    cerr<<"Error - "<<errorMsg<<endl;
+    cerr<<"Usage -\n\t./getSccBench graph... [--alg algs] [--warmup n] [--runs n] [--threads n] [--multistep]"
+        " [--order order] [--compress] [--back p] [--seed n] [--format format] [--output outputFile]"<<endl<<endl;
+    cerr<<"\tgraph - file:graphFile, rmat:SCALE:EDGEFACTOR, er:V:E or grid:ROWS:COLS"<<endl;
+    cerr<<"\t--alg algs - comma separated algorithms to run (dfs, dcsc, tarjan, pdcsc or color, defaults to all)"<<endl;
+    cerr<<"\t--warmup n - untimed runs before the timed ones (defaults to 1)"<<endl;
+    cerr<<"\t--runs n - timed runs (defaults to 5)"<<endl;
+    cerr<<"\t--threads n - number of threads used by parallel algorithms (defaults to all cores)"<<endl;
+    cerr<<"\t--multistep - trim trivial components and the giant component before running the algorithms"<<endl;
+    cerr<<"\t--order order - relabel the vertices before running the algorithms (none, degree, rcm or gorder)"<<endl;
+    cerr<<"\t--compress - run dfs and dcsc on gap encoded neighbour lists, reporting the adjacency bytes"<<endl;
+    cerr<<"\t--back p - direct generated edges from smaller to larger vertex, reversing each with probability p"<<endl;
+    cerr<<"\t--seed n - seed of the generators (defaults to 1)"<<endl;
+    cerr<<"\t--format format - csv, json or results (the lines of the results files, defaults to csv)"<<endl;
+    cerr<<"\t--output outputFile - file written instead of the standard output, appended to for results"<<endl;
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * \brief Loads or generates a graph given on the command line, and returns its name.
+ */
+static string loadGraph(const char* spec, const GeneratorOptions& options, int noThreads, EdgeList& edges, int& graphSize)
+{
+    string name;
+    if(!strncmp(spec, "file:", 5))
+    {
+        name = spec + 5;
+        if(!loadEdgeList(spec + 5, 2, 2, edges, noThreads))
+        {
+            displayBenchError("Cannot open graph file " + name + ".");
+        }
+
+        vector<int> originalIds;
+        graphSize = max((int)edges.header[0], remapVertexIds(edges.columns[0], edges.columns[1], originalIds, noThreads));
+        return name;
+    }
+
+    if(!generateGraph(spec, options, edges, name) || edges.header.size() != 2)
+    {
+        displayBenchError(string("Invalid graph ") + spec + ".");
+    }
+    graphSize = edges.header[0];
+    return name;
+}
+
+int main(int argc, char** argv)
+{
+    vector<char*> specs;
+    vector<bool> engines(NO_ENGINES, true);
+    int noWarmup = 1, noRuns = 5;
+    int noThreads = max((int)thread::hardware_concurrency(), 1);
+    bool multistep = false, compress = false;
+    ORDER_TYPE order = ORDER_NONE;
+    GeneratorOptions options;
+    BENCH_FORMAT format = BENCH_CSV;
+    char* outputFile = nullptr;
+    for(int i=1;i<argc;i++)
+    {
+        if(!strcmp(argv[i], "--alg"))
+        {
+            if(i + 1 == argc)
+            {
+                displayBenchError("Missing algorithms.");
+            }
+
+            string names = string(argv[++i]) + ",";
+            fill(engines.begin(), engines.end(), false);
+            for(size_t start = 0, comma; (comma = names.find(',', start)) != string::npos; start = comma + 1)
+            {
+                int engine = find(ENGINE_NAMES, ENGINE_NAMES + NO_ENGINES, names.substr(start, comma - start)) - ENGINE_NAMES;
+                if(engine == NO_ENGINES)
+                {
+                    displayBenchError("Unknown algorithm for getting components.");
+                }
+                engines[engine] = true;
+            }
+        }
+        else if(!strcmp(argv[i], "--warmup"))
+        {
+            if(i + 1 == argc || (noWarmup = atoi(argv[++i])) < 0)
+            {
+                displayBenchError("Invalid number of warmup runs.");
+            }
+        }
+        else if(!strcmp(argv[i], "--runs"))
+        {
+            if(i + 1 == argc || (noRuns = atoi(argv[++i])) < 1)
+            {
+                displayBenchError("Invalid number of runs.");
+            }
+        }
+        else if(!strcmp(argv[i], "--threads"))
+        {
+            if(i + 1 == argc || (noThreads = atoi(argv[++i])) < 1)
+            {
+                displayBenchError("Invalid number of threads.");
+            }
+        }
+        else if(!strcmp(argv[i], "--multistep"))
+        {
+            multistep = true;
+        }
+        else if(!strcmp(argv[i], "--compress"))
+        {
+            compress = true;
+        }
+        else if(!strcmp(argv[i], "--order"))
+        {
+            if(i + 1 == argc || !parseVertexOrder(argv[++i], order))
+            {
+                displayBenchError("Unknown vertex order.");
+            }
+        }
+        else if(!strcmp(argv[i], "--back"))
+        {
+            if(i + 1 == argc || (options.backProbability = atof(argv[++i])) < 0 || options.backProbability > 1)
+            {
+                displayBenchError("Invalid back-edge probability.");
+            }
+        }
+        else if(!strcmp(argv[i], "--seed"))
+        {
+            if(i + 1 == argc)
+            {
+                displayBenchError("Missing seed.");
+            }
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        }
+        else if(!strcmp(argv[i], "--format"))
+        {
+            if(i + 1 == argc || !parseBenchFormat(argv[++i], format))
+            {
+                displayBenchError("Unknown output format.");
+            }
+        }
+        else if(!strcmp(argv[i], "--output"))
+        {
+            if(i + 1 == argc)
+            {
+                displayBenchError("Missing output file.");
+            }
+            outputFile = argv[++i];
+        }
+        else
+        {
+            specs.push_back(argv[i]);
+        }
+    }
+
+    if(specs.empty())
+    {
+        displayBenchError("No graph given.");
+    }
+
+    if(format == BENCH_RESULTS && count(engines.begin(), engines.end(), true) > 1)
+    {
+        displayBenchError("The results format takes a single algorithm, as every results file holds one.");
+    }
+
+    vector<BenchRecord> records;
+    for(auto spec : specs)
+    {
+        EdgeList edges;
+        int graphSize;
+        string name = loadGraph(spec, options, noThreads, edges, graphSize);
+
+        DiGraph graph(graphSize);
+        graph.setNoThreads(noThreads);
+        graph.setMultistep(multistep);
+        graph.setCompressed(compress);
+        graph.addEdges(edges.columns[0], edges.columns[1]);
+        if(order != ORDER_NONE)
+        {
+            graph.reorderVertices(order);
+        }
+
+        for(int engine=0;engine<NO_ENGINES;engine++)
+        {
+            if(!engines[engine])
+            {
+                continue;
+            }
+
+            BenchRecord record;
+            record.graph = name;
+            record.engine = ENGINE_NAMES[engine];
+            record.noVertices = edges.header[0];
+            record.noEdges = edges.header[1];
+            record.noThreads = noThreads;
+
+            SccResult components;
+            runBenchmark(noWarmup, noRuns, [](){}, [&](){ components = graph.getComponentLabels((ALG_TYPE)engine); }, record);
+
+            record.values.push_back(make_pair("components", components.noComponents));
+            record.values.push_back(make_pair("max_component", components.maxComponentSize));
+            if(compress)
+            {
+                record.values.push_back(make_pair("adjacency_bytes", graph.getAdjacencySize()));
+            }
+            records.push_back(record);
+
+            cerr<<name<<" "<<record.engine<<" - median "<<percentile(record.wallTimes, 50)<<" seconds"<<endl;
+        }
+    }
+
+    if(!outputFile)
+    {
+        writeBenchRecords(cout, records, format);
+        return 0;
+    }
+
+    ofstream out(outputFile, format == BENCH_RESULTS ? ios_base::app : ios_base::trunc);
+    if(!out.is_open())
+    {
+        displayBenchError("Cannot open output file.");
+    }
+    writeBenchRecords(out, records, format);
+
+    return 0;
+}
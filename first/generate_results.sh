@@ -14,9 +14,5 @@ function exit_if_error() {
 make getScc
 exit_if_error
 
-for graph in $(ls graphs)
-do
-    echo "Running graph - $graph"
-    ./bin/getScc "./graphs/$graph" $1 $2 >/dev/null
-    exit_if_error
-done
+./bin/getScc ./graphs $1 $2 --batch
+exit_if_error
@@ -0,0 +1,192 @@
+#include<vector>
+#include<algorithm>
+#include<cstdint>
+#include<cstring>
+
+#include "compressed_adjacency.hpp"
+
+using namespace std;
+
+
+/**
+ * Largest number of vertices in a block of the list offsets, as a power of two.
+ */
+const int MAX_BLOCK_SHIFT = 16;
+
+/**
+ * Bytes of padding after the lists, so that a group is always loaded as 16 bytes.
+ */
+const int LIST_PADDING = 16;
+
+
+uint8_t CompressedAdjacency::groupLengths[256];
+uint8_t CompressedAdjacency::groupShuffles[256][16];
+
+/**
+ * \brief Fills the tables of the control bytes once, before main.
+ */
+static struct GroupTables
+{
+    GroupTables()
+    {
+        for(int key=0;key<256;key++)
+        {
+            int offset = 0;
+            for(int i=0;i<4;i++)
+            {
+                int length = (key >> (2 * i) & 3) + 1;
+                for(int b=0;b<4;b++)
+                {
+                    CompressedAdjacency::groupShuffles[key][4*i+b] = b < length ? offset + b : 0x80;
+                }
+                offset += length;
+            }
+            CompressedAdjacency::groupLengths[key] = offset;
+        }
+    }
+} groupTables;
+
+/**
+ * \brief Writes a LEB128 varint, advancing the pointer past it.
+ */
+static void writeVarint(uint8_t*& out, uint32_t value)
+{
+    while(value >= 0x80)
+    {
+        *out++ = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    *out++ = value;
+}
+
+/**
+ * \brief Returns the largest number of bytes taken by a list of the given degree.
+ */
+static size_t maxListSize(int degree)
+{
+    return 10 + (degree + 2) / 4 + 4 * (size_t)max(degree - 1, 0);
+}
+
+/**
+ * \brief Writes a sorted neighbour list of a vertex in the layout of CompressedAdjacency,
+ * and returns the end of the list.
+ */
+static uint8_t* encodeList(uint8_t* out, int vertex, const int* neighbours, int degree)
+{
+    writeVarint(out, degree);
+    if(!degree)
+    {
+        return out;
+    }
+    uint32_t delta = (uint32_t)neighbours[0] - (uint32_t)vertex;
+    writeVarint(out, (delta << 1) ^ (uint32_t)((int)delta >> 31));
+
+    uint8_t* control = out;
+    out += (degree + 2) / 4;
+    memset(control, 0, out - control);
+    for(int i=1;i<degree;i++)
+    {
+        uint32_t gap = neighbours[i] - neighbours[i-1];
+        int length = (39 - __builtin_clz(gap | 1)) >> 3;
+        control[(i - 1) / 4] |= (length - 1) << (2 * ((i - 1) & 3));
+        memcpy(out, &gap, 4);
+        out += length;
+    }
+    return out;
+}
+
+CompressedAdjacency::CompressedAdjacency()
+{
+    noVertices = 0;
+    edgeCount = 0;
+    blockShift = MAX_BLOCK_SHIFT;
+}
+
+void CompressedAdjacency::build(int noVertices, const int* offsets, const int* targets)
+{
+    this->noVertices = noVertices;
+    edgeCount = offsets[noVertices];
+
+    vector<uint8_t> encoded(edgeCount + noVertices + LIST_PADDING);
+    size_t used = 0;
+    vector<uint64_t> starts(noVertices + 1);
+    vector<int> neighbours;
+    for(int v=0;v<noVertices;v++)
+    {
+        starts[v] = used;
+        const int* list = targets + offsets[v];
+        int degree = offsets[v+1] - offsets[v];
+        if(!is_sorted(list, list + degree))
+        {
+            neighbours.assign(list, list + degree);
+            sort(neighbours.begin(), neighbours.end());
+            list = neighbours.data();
+        }
+
+        if(used + maxListSize(degree) > encoded.size())
+        {
+            encoded.resize(max(encoded.size() * 3 / 2, used + maxListSize(degree)));
+        }
+        used = encodeList(encoded.data() + used, v, list, degree) - encoded.data();
+    }
+    starts[noVertices] = used;
+    encoded.resize(used + LIST_PADDING);
+    fill(encoded.begin() + used, encoded.end(), 0);
+    encoded.shrink_to_fit();
+    bytes.swap(encoded);
+
+    /*
+     * Blocks are made smaller until the lists of every block span less than 4 GiB.
+     */
+    blockShift = MAX_BLOCK_SHIFT;
+    for(bool fits=false;!fits && blockShift>0;)
+    {
+        fits = true;
+        for(long long v=0;v<noVertices && fits;v+=1LL<<blockShift)
+        {
+            long long last = min(v + (1LL << blockShift), (long long)noVertices);
+            fits = starts[last] - starts[v] < (1ULL << 32);
+        }
+        blockShift -= !fits;
+    }
+
+    blockStarts.assign((noVertices >> blockShift) + 1, 0);
+    listStarts.resize(noVertices);
+    for(int v=0;v<noVertices;v++)
+    {
+        if(!(v & ((1 << blockShift) - 1)))
+        {
+            blockStarts[v >> blockShift] = starts[v];
+        }
+        listStarts[v] = starts[v] - blockStarts[v >> blockShift];
+    }
+}
+
+void CompressedAdjacency::decode(vector<int>& offsets, vector<int>& targets) const
+{
+    offsets.assign(noVertices + 1, 0);
+    targets.resize(edgeCount);
+    for(int v=0;v<noVertices;v++)
+    {
+        int position = offsets[v];
+        for(int neighbour : neighbours(v))
+        {
+            targets[position++] = neighbour;
+        }
+        offsets[v+1] = position;
+    }
+}
+
+void CompressedAdjacency::clear()
+{
+    noVertices = 0;
+    edgeCount = 0;
+    vector<uint8_t>().swap(bytes);
+    vector<uint32_t>().swap(listStarts);
+    vector<uint64_t>().swap(blockStarts);
+}
+
+long long CompressedAdjacency::size() const
+{
+    return bytes.size() + listStarts.size() * sizeof(uint32_t) + blockStarts.size() * sizeof(uint64_t);
+}
@@ -0,0 +1,248 @@
+#ifndef compressed_adjacency_hpp
+#define compressed_adjacency_hpp
+
+#include<vector>
+#include<cstdint>
+#include<cstring>
+
+#ifdef __SSSE3__
+#include<tmmintrin.h>
+#endif
+
+/**
+ * \brief Forward iterator over a neighbour list of a CompressedAdjacency, decoding the
+ * list four neighbours at a time.
+ */
+class NeighbourIterator
+{
+    private:
+        /**
+         * Next control byte, and the data bytes of the group it describes.
+         */
+        const uint8_t* control;
+        const uint8_t* data;
+
+        /**
+         * Number of neighbours not yet passed, including the current one.
+         */
+        int remaining;
+
+        /**
+         * Neighbours of the group being read, and the position of the current one.
+         */
+        uint32_t group[4];
+        int index;
+
+        /**
+         * \brief Decodes the next group of gaps, adding them to the last neighbour decoded.
+         */
+        inline void decodeGroup();
+
+    public:
+        /**
+         * \brief Creates an iterator past the end of a list.
+         */
+        NeighbourIterator() : control(nullptr), data(nullptr), remaining(0), index(0) {}
+
+        /**
+         * \brief Creates an iterator at the first neighbour of a list.
+         *
+         * @param control - control bytes of the list
+         * @param degree - number of neighbours in the list
+         * @param first - first neighbour
+         */
+        inline NeighbourIterator(const uint8_t* control, int degree, int first);
+
+        int operator*() const { return group[index]; }
+        inline NeighbourIterator& operator++();
+        bool operator!=(const NeighbourIterator& other) const { return remaining != other.remaining; }
+};
+
+/**
+ * \brief Neighbour list of a CompressedAdjacency, iterated with a range-based for loop.
+ */
+struct NeighbourList
+{
+    NeighbourIterator first;
+    NeighbourIterator begin() const { return first; }
+    NeighbourIterator end() const { return NeighbourIterator(); }
+};
+
+/**
+ * Class template for a compressed adjacency of a digraph.
+ *
+ * Every neighbour list is sorted and stored as gaps between consecutive neighbours in
+ * the layout of Lemire et al.'s Stream VByte: a control byte holding the byte length (1
+ * to 4) of four gaps, followed by the bytes of those gaps. A list starts with its degree
+ * and its first neighbour, less the vertex itself and zigzag encoded, as LEB128 varints.
+ * A group of four gaps is decoded with one byte shuffle and a prefix sum when SSSE3 is
+ * available, and with four masked loads otherwise.
+ *
+ * Lists are located through a 32-bit offset per vertex, relative to a 64-bit offset per
+ * block of vertices.
+ */
+class CompressedAdjacency
+{
+    private:
+        /**
+         * Number of vertices and edges.
+         */
+        int noVertices;
+        long long edgeCount;
+
+        /**
+         * Encoded lists of all the vertices, followed by padding for the unaligned loads.
+         */
+        std::vector<uint8_t> bytes;
+
+        /**
+         * Start of the list of every vertex, relative to the start of its block.
+         */
+        std::vector<uint32_t> listStarts;
+
+        /**
+         * Start of every block of 2^blockShift vertices in bytes.
+         */
+        std::vector<uint64_t> blockStarts;
+        int blockShift;
+
+        /**
+         * \brief Returns the encoded list of a vertex.
+         */
+        const uint8_t* list(int vertex) const
+        {
+            return bytes.data() + blockStarts[vertex >> blockShift] + listStarts[vertex];
+        }
+
+    public:
+        /**
+         * Byte length of the four gaps of every control byte, and the shuffle gathering
+         * them into four 32-bit lanes.
+         */
+        static uint8_t groupLengths[256];
+        static uint8_t groupShuffles[256][16];
+
+        /**
+         * \brief Creates an empty adjacency.
+         */
+        CompressedAdjacency();
+
+        /**
+         * \brief Encodes a CSR adjacency, replacing the lists held before.
+         *
+         * @param noVertices - number of vertices
+         * @param offsets - offsets into targets for every vertex, with a sentinel entry at the end
+         * @param targets - neighbours of all the vertices
+         */
+        void build(int noVertices, const int* offsets, const int* targets);
+
+        /**
+         * \brief Decodes the lists into a CSR adjacency, every list in increasing order.
+         *
+         * @param offsets - filled with the offsets into targets for every vertex, with a sentinel entry at the end
+         * @param targets - filled with the neighbours of all the vertices
+         */
+        void decode(std::vector<int>& offsets, std::vector<int>& targets) const;
+
+        /**
+         * \brief Frees the lists.
+         */
+        void clear();
+
+        /**
+         * \brief Returns the number of edges.
+         */
+        long long noEdges() const { return edgeCount; }
+
+        /**
+         * \brief Returns the number of bytes used by the adjacency.
+         */
+        long long size() const;
+
+        /**
+         * \brief Returns the number of neighbours of a vertex.
+         */
+        inline int degree(int vertex) const;
+
+        /**
+         * \brief Returns the neighbours of a vertex, in increasing order.
+         */
+        inline NeighbourList neighbours(int vertex) const;
+};
+
+/**
+ * \brief Reads a LEB128 varint, advancing the pointer past it.
+ */
+inline uint32_t readVarint(const uint8_t*& in)
+{
+    uint32_t value = *in & 0x7f;
+    for(int shift=7;*in++ & 0x80;shift+=7)
+    {
+        value |= (uint32_t)(*in & 0x7f) << shift;
+    }
+    return value;
+}
+
+inline NeighbourIterator::NeighbourIterator(const uint8_t* control, int degree, int first)
+{
+    this->control = control;
+    this->data = control + (degree + 2) / 4;
+    remaining = degree;
+    group[3] = first;
+    index = 3;
+}
+
+inline void NeighbourIterator::decodeGroup()
+{
+    uint8_t key = *control++;
+#ifdef __SSSE3__
+    __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data),
+        _mm_loadu_si128((const __m128i*)CompressedAdjacency::groupShuffles[key]));
+    gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+    gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+    gaps = _mm_add_epi32(gaps, _mm_set1_epi32(group[3]));
+    _mm_storeu_si128((__m128i*)group, gaps);
+    data += CompressedAdjacency::groupLengths[key];
+#else
+    uint32_t previous = group[3];
+    for(int i=0;i<4;i++)
+    {
+        int length = (key >> (2 * i) & 3) + 1;
+        uint32_t gap;
+        memcpy(&gap, data, 4);
+        previous += gap & (0xffffffffu >> (32 - 8 * length));
+        group[i] = previous;
+        data += length;
+    }
+#endif
+}
+
+inline NeighbourIterator& NeighbourIterator::operator++()
+{
+    if(--remaining && ++index == 4)
+    {
+        decodeGroup();
+        index = 0;
+    }
+    return *this;
+}
+
+inline int CompressedAdjacency::degree(int vertex) const
+{
+    const uint8_t* in = list(vertex);
+    return readVarint(in);
+}
+
+inline NeighbourList CompressedAdjacency::neighbours(int vertex) const
+{
+    const uint8_t* in = list(vertex);
+    int degree = readVarint(in);
+    if(!degree)
+    {
+        return NeighbourList();
+    }
+    uint32_t first = readVarint(in);
+    return NeighbourList{NeighbourIterator(in, degree, vertex + (int)((first >> 1) ^ -(first & 1)))};
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include<vector>
+#include<algorithm>
+#include<climits>
+
+#include "reachability.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+
+/**
+ * Number of queries of a batch handed to a thread at a time.
+ */
+const int QUERY_GRAIN = 1 << 12;
+
+
+ReachabilityIndex::ReachabilityIndex() : noComponents(0), noLabels(0), noThreads(1)
+{
+    condensation.offsetStorage.assign(1, 0);
+    condensation.useStorage();
+}
+
+void ReachabilityIndex::build(const SccResult& components, const CSRAdjacency& adjacency, const vector<int>& vertexOrder,
+    int noLabels, int noThreads)
+{
+    this->noComponents = components.noComponents;
+    this->noLabels = max(noLabels, 1);
+    this->noThreads = max(noThreads, 1);
+    componentOf = components.componentOf;
+
+    buildCondensation(components, adjacency, vertexOrder);
+
+    intervals.assign(2 * this->noLabels * noComponents, 0);
+    treeLow.assign(noComponents, 0);
+    for(int labelNo=0;labelNo<this->noLabels;labelNo++)
+    {
+        labelComponents(labelNo);
+    }
+
+    searchStates.assign(this->noThreads, SearchState());
+    for(auto& state : searchStates)
+    {
+        state.mark.assign(noComponents, 0);
+        state.stamp = 0;
+    }
+}
+
+void ReachabilityIndex::buildCondensation(const SccResult& components, const CSRAdjacency& adjacency,
+    const vector<int>& vertexOrder)
+{
+    vector<int> reorderedComponentOf;
+    const int* componentOfRow = componentOf.data();
+    if(!vertexOrder.empty())
+    {
+        reorderedComponentOf.resize(componentOf.size());
+        for(size_t v=0;v<componentOf.size();v++)
+        {
+            reorderedComponentOf[vertexOrder[v]] = componentOf[v];
+        }
+        componentOfRow = reorderedComponentOf.data();
+    }
+
+    vector<int>& offsets = condensation.offsetStorage;
+    vector<int>& targets = condensation.targetStorage;
+    offsets.assign(noComponents + 1, 0);
+    targets.clear();
+
+    /*
+     * The vertices of every component are contiguous, so the edges leaving a component are
+     * gathered in one go, and lastSource removes the duplicates among them.
+     */
+    vector<int> lastSource(noComponents, -1);
+    for(int c=0;c<noComponents;c++)
+    {
+        lastSource[c] = c;
+        for(int i=components.offsets[c];i<components.offsets[c+1];i++)
+        {
+            int x = components.vertices[i];
+            if(!vertexOrder.empty())
+            {
+                x = vertexOrder[x];
+            }
+            for(int j=adjacency.offsets[x];j<adjacency.offsets[x+1];j++)
+            {
+                int d = componentOfRow[adjacency.targets[j]];
+                if(lastSource[d] != c)
+                {
+                    lastSource[d] = c;
+                    targets.push_back(d);
+                }
+            }
+        }
+        offsets[c+1] = targets.size();
+    }
+
+    targets.shrink_to_fit();
+    condensation.useStorage();
+}
+
+void ReachabilityIndex::labelComponents(int labelNo)
+{
+    const int* offsets = condensation.offsets;
+    const int* targets = condensation.targets;
+    int* interval = intervals.data() + 2 * labelNo;
+    int stride = 2 * noLabels;
+
+    /*
+     * Roots and children are visited from a rotated position, which differs between
+     * labellings, so every labelling sees another spanning forest.
+     */
+    unsigned seed = 2654435761u * (labelNo + 1);
+    auto rotation = [seed](int c, int degree) { return degree ? (int)(((unsigned)c * 40503u + seed) % degree) : 0; };
+
+    vector<char> visited(noComponents, 0);
+    vector<pair<int, int> > stack;
+    int nextNumber = 0;
+    int rootStart = rotation(labelNo, noComponents);
+    for(int r=0;r<noComponents;r++)
+    {
+        int root = (rootStart + r) % noComponents;
+        if(visited[root])
+        {
+            continue;
+        }
+
+        visited[root] = 1;
+        if(labelNo == 0)
+        {
+            treeLow[root] = nextNumber;
+        }
+        stack.push_back(make_pair(root, 0));
+        while(!stack.empty())
+        {
+            int curr = stack.back().first;
+            int degree = offsets[curr+1] - offsets[curr];
+            int& next = stack.back().second;
+
+            if(next < degree)
+            {
+                int child = targets[offsets[curr] + (rotation(curr, degree) + next) % degree];
+                next++;
+                if(!visited[child])
+                {
+                    visited[child] = 1;
+                    if(labelNo == 0)
+                    {
+                        treeLow[child] = nextNumber;
+                    }
+                    stack.push_back(make_pair(child, 0));
+                }
+                continue;
+            }
+
+            int number = nextNumber++;
+            int low = number;
+            for(int i=offsets[curr];i<offsets[curr+1];i++)
+            {
+                low = min(low, interval[targets[i] * stride]);
+            }
+            interval[curr * stride] = low;
+            interval[curr * stride + 1] = number;
+            stack.pop_back();
+        }
+    }
+}
+
+bool ReachabilityIndex::nested(int from, int to) const
+{
+    const int* outer = intervals.data() + 2 * noLabels * from;
+    const int* inner = intervals.data() + 2 * noLabels * to;
+    for(int labelNo=0;labelNo<noLabels;labelNo++)
+    {
+        if(inner[2*labelNo] < outer[2*labelNo] || inner[2*labelNo+1] > outer[2*labelNo+1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReachabilityIndex::inTree(int from, int to) const
+{
+    int number = intervals[2 * noLabels * to + 1];
+    return treeLow[from] <= number && number <= intervals[2 * noLabels * from + 1];
+}
+
+bool ReachabilityIndex::componentReaches(int from, int to, SearchState& state)
+{
+    if(from == to || inTree(from, to))
+    {
+        return true;
+    }
+    if(!nested(from, to))
+    {
+        return false;
+    }
+
+    const int* offsets = condensation.offsets;
+    const int* targets = condensation.targets;
+
+    if(state.stamp == INT_MAX)
+    {
+        fill(state.mark.begin(), state.mark.end(), 0);
+        state.stamp = 0;
+    }
+    int stamp = ++state.stamp;
+    state.stack.assign(1, from);
+    state.mark[from] = stamp;
+    while(!state.stack.empty())
+    {
+        int curr = state.stack.back();
+        state.stack.pop_back();
+
+        for(int i=offsets[curr];i<offsets[curr+1];i++)
+        {
+            int child = targets[i];
+            if(state.mark[child] == stamp)
+            {
+                continue;
+            }
+            state.mark[child] = stamp;
+
+            if(child == to || inTree(child, to))
+            {
+                return true;
+            }
+            if(nested(child, to))
+            {
+                state.stack.push_back(child);
+            }
+        }
+    }
+
+    return false;
+}
+
+const CSRAdjacency& ReachabilityIndex::getCondensation()
+{
+    return condensation;
+}
+
+bool ReachabilityIndex::reaches(int u, int v)
+{
+    return componentReaches(componentOf[u], componentOf[v], searchStates[0]);
+}
+
+void ReachabilityIndex::reachesBatch(const int* sources, const int* targets, int noQueries, char* answers)
+{
+    ThreadPool pool(noThreads);
+    pool.parallelFor(0, noQueries, QUERY_GRAIN, [&](int begin, int end)
+    {
+        SearchState& state = searchStates[ThreadPool::threadIndex()];
+        for(int i=begin;i<end;i++)
+        {
+            answers[i] = sources[i] >= 0 && targets[i] >= 0 &&
+                componentReaches(componentOf[sources[i]], componentOf[targets[i]], state);
+        }
+    });
+}
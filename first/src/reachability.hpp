@@ -0,0 +1,140 @@
+#ifndef reachability_hpp
+#define reachability_hpp
+
+#include<vector>
+
+#include "scc.hpp"
+
+/**
+ * Class template for a reachability index over the condensation of a digraph.
+ *
+ * The strong components found by an SCC engine are contracted into the vertices of a DAG,
+ * stored in CSR form with duplicate edges removed. Every component then gets one interval
+ * per GRAIL labelling: a DFS of the DAG in a randomised order numbers the components in
+ * post-order, and the interval of a component runs from the smallest number found below
+ * it to its own number. If u reaches v, the intervals of v are nested in those of u, so
+ * most unreachable pairs are answered without a search. The spanning tree of the first DFS
+ * answers part of the reachable pairs in the same way, and the remaining pairs fall back to
+ * a DFS of the DAG that is pruned by the intervals.
+ */
+class ReachabilityIndex
+{
+    private:
+        /**
+         * Per-thread state of the fallback searches.
+         */
+        struct SearchState
+        {
+            std::vector<int> mark;
+            std::vector<int> stack;
+            int stamp;
+        };
+
+        /**
+         * Number of components, and number of GRAIL labellings.
+         */
+        int noComponents, noLabels;
+
+        /**
+         * Number of threads used for batches of queries.
+         */
+        int noThreads;
+
+        /**
+         * Component number of every vertex.
+         */
+        std::vector<int> componentOf;
+
+        /**
+         * Condensation DAG, with components as vertices.
+         */
+        CSRAdjacency condensation;
+
+        /**
+         * GRAIL intervals of every component, stored as noLabels pairs of (lowest, post-order number).
+         */
+        std::vector<int> intervals;
+
+        /**
+         * Post-order number of the first component of the spanning tree of the first labelling
+         * below every component.
+         */
+        std::vector<int> treeLow;
+
+        /**
+         * Search state of every thread of a batch.
+         */
+        std::vector<SearchState> searchStates;
+
+        /**
+         * \brief Builds the condensation from the component numbers and the digraph's edges.
+         */
+        void buildCondensation(const SccResult& components, const CSRAdjacency& adjacency,
+            const std::vector<int>& vertexOrder);
+
+        /**
+         * \brief Runs one randomised DFS of the condensation, and records its intervals.
+         *
+         * @param labelNo - number of the labelling
+         */
+        void labelComponents(int labelNo);
+
+        /**
+         * \brief Returns whether the intervals of component to are nested in those of component from.
+         */
+        bool nested(int from, int to) const;
+
+        /**
+         * \brief Returns whether component to lies below component from in the first spanning tree.
+         */
+        bool inTree(int from, int to) const;
+
+        /**
+         * \brief Returns whether component from reaches component to.
+         *
+         * @param state - search state used for the fallback search
+         */
+        bool componentReaches(int from, int to, SearchState& state);
+
+    public:
+        /**
+         * \brief Creates an empty index.
+         */
+        ReachabilityIndex();
+
+        /**
+         * \brief Builds the index for a digraph from its strong components.
+         *
+         * @param components - strong components of the digraph
+         * @param adjacency - edges of the digraph
+         * @param vertexOrder - id of every vertex in adjacency, or empty if adjacency uses the
+         * ids of the components
+         * @param noLabels - number of GRAIL labellings, trading index size for fewer searches
+         * @param noThreads - number of threads used for batches of queries
+         */
+        void build(const SccResult& components, const CSRAdjacency& adjacency, const std::vector<int>& vertexOrder,
+            int noLabels, int noThreads);
+
+        /**
+         * \brief Returns the condensation DAG, component c having the edges of vertex c.
+         */
+        const CSRAdjacency& getCondensation();
+
+        /**
+         * \brief Returns whether vertex u reaches vertex v.
+         */
+        bool reaches(int u, int v);
+
+        /**
+         * \brief Answers a batch of queries in parallel, answers[i] telling whether sources[i]
+         * reaches targets[i]. Queries on negative vertices are answered false.
+         *
+         * @param sources - vertices the queries start from
+         * @param targets - vertices the queries look for
+         * @param noQueries - number of queries
+         * @param answers - filled with the answer to every query
+         */
+        void reachesBatch(const int* sources, const int* targets, int noQueries, char* answers);
+};
+
+#endif
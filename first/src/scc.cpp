@@ -2,225 +2,1864 @@
 #include<fstream>
 #include<string>
 #include<cstring>
-#include<sstream>
 #include<algorithm>
 #include<ctime>
-#include<unordered_map>
 #include<vector>
 #include<stack>
 #include<iomanip>
 #include<cstdlib>
+#include<atomic>
+#include<thread>
+#include<sstream>
+#include<memory>
 
 #include "scc.hpp"
+#include "thread_pool.hpp"
+#include "edge_loader.hpp"
+#include "graph_snapshot.hpp"
+#include "vertex_map.hpp"
+#include "scc_output.hpp"
+#include "reachability.hpp"
+#include "vertex_order.hpp"
+#include "perf_counters.hpp"
+#include "batch_runner.hpp"
+#include "semi_external.hpp"
 
 using namespace std;
 
 
-/**
- * Macro short-handfor printing a decimal x with a precision of y.
- */
-#define FIXED_FLOAT(x, y) fixed<<setprecision(y)<<(x)
+/**
+ * Macro short-handfor printing a decimal x with a precision of y.
+ */
+#define FIXED_FLOAT(x, y) fixed<<setprecision(y)<<(x)
+
+/**
+ * Partition label of the vertices whose strong components have already been found.
+ * Every other vertex carries a non-negative label, and edges are only followed between
+ * vertices sharing a label.
+ */
+const int LABEL_DONE = -1;
+
+/**
+ * Partition label that no vertex ever carries, used to disable a search rule.
+ */
+const int LABEL_NONE = -2;
+
+/**
+ * Frontier size above which the parallel DCSC searches expand a level in parallel.
+ */
+const int PARALLEL_FRONTIER = 1024;
+
+/**
+ * Sub-graph size above which the parallel DCSC algorithm spawns a sub-graph as a new task.
+ */
+const int PARALLEL_SPAWN = 256;
+
+/**
+ * Sub-graph size from which the DCSC searches are direction-optimizing.
+ */
+const int SWEEP_SUBGRAPH = 1 << 12;
+
+/**
+ * A direction-optimizing search turns bottom-up once the last level has more than
+ * 1 / SWEEP_ALPHA of the edges of the unreached vertices, and back top-down once the
+ * last level holds less than 1 / SWEEP_BETA of the sub-graph.
+ */
+const int SWEEP_ALPHA = 14;
+const int SWEEP_BETA = 24;
+
+/**
+ * In incremental mode, a batch of edges is added by recomputing the components if it
+ * holds at least one edge per this many edges of the digraph.
+ */
+const int INCREMENTAL_BATCH_RATIO = 8;
+
+/**
+ * Number of GRAIL labellings of the reachability index built for --queries.
+ */
+const int REACHABILITY_LABELS = 3;
+
+
+/**
+ * \brief Returns the number of edges of an adjacency.
+ */
+static long long countEdges(const CSRAdjacency& adjSet, int noVertices)
+{
+    return adjSet.offsets[noVertices];
+}
+
+static long long countEdges(const CompressedAdjacency& adjSet, int)
+{
+    return adjSet.noEdges();
+}
+
+/**
+ * \brief Returns whether two results group the vertices into the same components.
+ */
+static bool samePartition(const SccResult& first, const SccResult& second)
+{
+    if(first.noComponents != second.noComponents || first.componentOf.size() != second.componentOf.size())
+    {
+        return false;
+    }
+
+    vector<int> match(first.noComponents, -1);
+    for(size_t vertex=0;vertex<first.componentOf.size();vertex++)
+    {
+        int& id = match[first.componentOf[vertex]];
+        if(id == -1)
+        {
+            id = second.componentOf[vertex];
+        }
+        else if(id != second.componentOf[vertex])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CSRAdjacency::useStorage()
+{
+    offsets = offsetStorage.data();
+    targets = targetStorage.data();
+}
+
+DiGraph::DiGraph(int noVertices)
+{
+    this->noVertices = noVertices;
+    this->noThreads = 1;
+    this->multistep = false;
+    adj.offsetStorage.assign(noVertices + 1, 0);
+    adj.useStorage();
+    adjBuilt = true;
+    transposeBuilt = false;
+    compressed = false;
+    compressedBuilt = false;
+    incremental = false;
+    noComponents = 0;
+    searchStamp = 0;
+}
+
+void DiGraph::addEdge(int x, int y)
+{
+    if(!vertexOrder.empty())
+    {
+        x = vertexOrder[x];
+        y = vertexOrder[y];
+    }
+
+    edgeSources.push_back(x);
+    edgeTargets.push_back(y);
+    adjBuilt = false;
+
+    if(incremental)
+    {
+        insertEdge(x, y);
+    }
+}
+
+void DiGraph::addEdges(vector<int>& sources, vector<int>& targets)
+{
+    if(!vertexOrder.empty())
+    {
+        for(size_t i=0;i<sources.size();i++)
+        {
+            sources[i] = vertexOrder[sources[i]];
+            targets[i] = vertexOrder[targets[i]];
+        }
+    }
+
+    bool recompute = false;
+    if(incremental)
+    {
+        long long noEdges = adj.offsets[noVertices] + edgeSources.size();
+        if((long long)sources.size() * INCREMENTAL_BATCH_RATIO < noEdges)
+        {
+            for(size_t i=0;i<sources.size();i++)
+            {
+                edgeSources.push_back(sources[i]);
+                edgeTargets.push_back(targets[i]);
+                insertEdge(sources[i], targets[i]);
+            }
+            adjBuilt = false;
+            vector<int>().swap(sources);
+            vector<int>().swap(targets);
+            return;
+        }
+        recompute = true;
+    }
+
+    if(edgeSources.empty())
+    {
+        edgeSources.swap(sources);
+        edgeTargets.swap(targets);
+    }
+    else
+    {
+        edgeSources.insert(edgeSources.end(), sources.begin(), sources.end());
+        edgeTargets.insert(edgeTargets.end(), targets.begin(), targets.end());
+    }
+    adjBuilt = false;
+
+    if(recompute)
+    {
+        startIncremental(incrementalAlg);
+    }
+}
+
+void DiGraph::setNoThreads(int noThreads)
+{
+    this->noThreads = max(noThreads, 1);
+}
+
+void DiGraph::setMultistep(bool multistep)
+{
+    this->multistep = multistep;
+}
+
+void DiGraph::setCompressed(bool compressed)
+{
+    this->compressed = compressed;
+}
+
+long long DiGraph::getAdjacencySize()
+{
+    if(compressedBuilt)
+    {
+        return compressedAdj.size() + compressedTranspose.size();
+    }
+
+    buildAdjacency();
+    long long noEdges = adj.offsets[noVertices];
+    long long size = (noVertices + 1 + noEdges) * sizeof(int);
+    return transposeBuilt ? 2 * size : size;
+}
+
+void DiGraph::setAdjacency(const int* offsets, const int* targets)
+{
+    vector<int>().swap(edgeSources);
+    vector<int>().swap(edgeTargets);
+    vector<int>().swap(adj.offsetStorage);
+    vector<int>().swap(adj.targetStorage);
+    compressedAdj.clear();
+    compressedTranspose.clear();
+    compressedBuilt = false;
+
+    adj.offsets = offsets;
+    adj.targets = targets;
+    adjBuilt = true;
+    transposeBuilt = false;
+
+    vector<int>().swap(vertexOrder);
+    vector<int>().swap(vertexOrigin);
+}
+
+void DiGraph::reorderVertices(ORDER_TYPE order)
+{
+    if(incremental)
+    {
+        stopIncremental();
+    }
+    buildAdjacency();
+    PERF_REGION("ordering");
+
+    vector<int> newId;
+    computeVertexOrder(order, noVertices, adj.offsets, adj.targets, newId);
+
+    vector<int> offsets(noVertices + 1, 0), targets(adj.offsets[noVertices]);
+    for(int x=0;x<noVertices;x++)
+    {
+        offsets[newId[x]+1] = adj.offsets[x+1] - adj.offsets[x];
+    }
+    for(int x=0;x<noVertices;x++)
+    {
+        offsets[x+1] += offsets[x];
+    }
+    for(int x=0;x<noVertices;x++)
+    {
+        int position = offsets[newId[x]];
+        for(int i=adj.offsets[x];i<adj.offsets[x+1];i++)
+        {
+            targets[position++] = newId[adj.targets[i]];
+        }
+    }
+
+    adj.offsetStorage.swap(offsets);
+    adj.targetStorage.swap(targets);
+    adj.useStorage();
+    transposeBuilt = false;
+
+    if(vertexOrder.empty())
+    {
+        vertexOrder.swap(newId);
+    }
+    else
+    {
+        for(auto& id : vertexOrder)
+        {
+            id = newId[id];
+        }
+    }
+    vertexOrigin.resize(noVertices);
+    for(int v=0;v<noVertices;v++)
+    {
+        vertexOrigin[vertexOrder[v]] = v;
+    }
+}
+
+const vector<int>& DiGraph::getVertexOrder()
+{
+    return vertexOrder;
+}
+
+const CSRAdjacency& DiGraph::getAdjacency()
+{
+    buildAdjacency();
+    return adj;
+}
+
+void DiGraph::buildAdjacency()
+{
+    expandAdjacency();
+    if(adjBuilt)
+    {
+        return;
+    }
+    PERF_REGION("adjacency");
+
+    vector<int> offsets(noVertices + 1, 0);
+    for(int x=0;x<noVertices;x++)
+    {
+        offsets[x+1] = adj.offsets[x+1] - adj.offsets[x];
+    }
+    for(auto x : edgeSources)
+    {
+        offsets[x+1]++;
+    }
+    for(int x=0;x<noVertices;x++)
+    {
+        offsets[x+1] += offsets[x];
+    }
+
+    vector<int> targets(offsets[noVertices]);
+    vector<int> position(offsets.begin(), offsets.end() - 1);
+    for(int x=0;x<noVertices;x++)
+    {
+        for(int i=adj.offsets[x];i<adj.offsets[x+1];i++)
+        {
+            targets[position[x]++] = adj.targets[i];
+        }
+    }
+    for(size_t i=0;i<edgeSources.size();i++)
+    {
+        targets[position[edgeSources[i]]++] = edgeTargets[i];
+    }
+
+    adj.offsetStorage.swap(offsets);
+    adj.targetStorage.swap(targets);
+    adj.useStorage();
+    vector<int>().swap(edgeSources);
+    vector<int>().swap(edgeTargets);
+
+    adjBuilt = true;
+    transposeBuilt = false;
+}
+
+void DiGraph::buildTranspose()
+{
+    buildAdjacency();
+    if(transposeBuilt)
+    {
+        return;
+    }
+    PERF_REGION("transpose");
+
+    vector<int>& offsets = transposeAdj.offsetStorage;
+    vector<int>& targets = transposeAdj.targetStorage;
+
+    offsets.assign(noVertices + 1, 0);
+    for(int i=0;i<adj.offsets[noVertices];i++)
+    {
+        offsets[adj.targets[i]+1]++;
+    }
+    for(int y=0;y<noVertices;y++)
+    {
+        offsets[y+1] += offsets[y];
+    }
+
+    targets.resize(adj.offsets[noVertices]);
+    vector<int> position(offsets.begin(), offsets.end() - 1);
+    for(int x=0;x<noVertices;x++)
+    {
+        for(int i=adj.offsets[x];i<adj.offsets[x+1];i++)
+        {
+            targets[position[adj.targets[i]]++] = x;
+        }
+    }
+    transposeAdj.useStorage();
+
+    transposeBuilt = true;
+}
+
+void DiGraph::compressAdjacency()
+{
+    if(compressedBuilt)
+    {
+        return;
+    }
+    buildTranspose();
+    PERF_REGION("compression");
+
+    compressedAdj.build(noVertices, adj.offsets, adj.targets);
+    compressedTranspose.build(noVertices, transposeAdj.offsets, transposeAdj.targets);
+
+    vector<int>().swap(adj.offsetStorage);
+    vector<int>().swap(adj.targetStorage);
+    vector<int>().swap(transposeAdj.offsetStorage);
+    vector<int>().swap(transposeAdj.targetStorage);
+    adj.offsets = adj.targets = nullptr;
+    transposeAdj.offsets = transposeAdj.targets = nullptr;
+    transposeBuilt = false;
+    compressedBuilt = true;
+}
+
+void DiGraph::expandAdjacency()
+{
+    if(!compressedBuilt)
+    {
+        return;
+    }
+    PERF_REGION("expansion");
+
+    compressedAdj.decode(adj.offsetStorage, adj.targetStorage);
+    adj.useStorage();
+    compressedAdj.clear();
+    compressedTranspose.clear();
+    compressedBuilt = false;
+}
+
+template<class Adjacency>
+void DiGraph::fillStack(const Adjacency& forward, const vector<int>& label, vector<bool>& visited, stack<int>& visitOrder)
+{
+    /*
+     * Every entry of callStack holds a vertex on the search path and the part of its
+     * neighbour list not yet scanned, whose first member is advanced past every neighbour.
+     */
+    typedef decltype(forward.neighbours(0)) Neighbours;
+    vector<pair<int, Neighbours> > callStack;
+
+    for(int start=0;start<noVertices;start++)
+    {
+        if(visited[start] || label[start] == LABEL_DONE)
+        {
+            continue;
+        }
+
+        visited[start] = true;
+        callStack.push_back(make_pair(start, forward.neighbours(start)));
+        while(!callStack.empty())
+        {
+            int curr = callStack.back().first;
+            Neighbours& rest = callStack.back().second;
+
+            if(rest.begin() != rest.end())
+            {
+                int neighbour = *rest.first;
+                ++rest.first;
+                if(label[neighbour] == label[curr] && !visited[neighbour])
+                {
+                    visited[neighbour] = true;
+                    callStack.push_back(make_pair(neighbour, forward.neighbours(neighbour)));
+                }
+                continue;
+            }
+
+            callStack.pop_back();
+            visitOrder.push(curr);
+        }
+    }
+}
+
+template<class Adjacency>
+void DiGraph::dfs(const Adjacency& forward, const Adjacency& reverse, const vector<int>& label, vector<int>& representative)
+{
+    vector<bool> visited(noVertices);
+
+    stack<int> visitOrder, dfsHelper;
+    {
+        PERF_REGION("dfs:finish-order");
+        fillStack(forward, label, visited, visitOrder);
+    }
+
+    PERF_REGION("dfs:transpose-search");
+    fill(visited.begin(), visited.end(), false);
+    while(!visitOrder.empty())
+    {
+        int curr = visitOrder.top();
+        visitOrder.pop();
+
+        if(visited[curr])
+        {
+            continue;
+        }
+
+        int root = curr;
+
+        dfsHelper.push(curr);
+        visited[curr] = true;
+        while(!dfsHelper.empty())
+        {
+            curr = dfsHelper.top();
+            dfsHelper.pop();
+
+            representative[curr] = root;
+
+            for(int neighbour : reverse.neighbours(curr))
+            {
+                if(!visited[neighbour] && label[neighbour] == label[curr])
+                {
+                    visited[neighbour] = true;
+                    dfsHelper.push(neighbour);
+                }
+            }
+        }
+    }
+}
+
+void DiGraph::tarjan(const vector<int>& label, vector<int>& representative)
+{
+    PERF_REGION("tarjan");
+
+    /*
+     * rindex holds the visitation index of a vertex while it is on the stack,
+     * and its component number (counting down from noVertices - 1) once its
+     * component has been found. Unvisited vertices have an rindex of 0.
+     */
+    vector<int> rindex(noVertices, 0);
+    vector<bool> root(noVertices);
+    vector<int> callStack, edgeIndex, componentStack;
+
+    int index = 1, componentNo = noVertices - 1;
+    for(int start=0;start<noVertices;start++)
+    {
+        if(rindex[start] || label[start] == LABEL_DONE)
+        {
+            continue;
+        }
+
+        callStack.push_back(start);
+        edgeIndex.push_back(adj.offsets[start]);
+        rindex[start] = index++;
+        root[start] = true;
+        while(!callStack.empty())
+        {
+            int curr = callStack.back();
+            int& i = edgeIndex.back();
+
+            if(i < adj.offsets[curr+1])
+            {
+                int neighbour = adj.targets[i++];
+                if(label[neighbour] != label[curr])
+                {
+                    continue;
+                }
+                if(!rindex[neighbour])
+                {
+                    callStack.push_back(neighbour);
+                    edgeIndex.push_back(adj.offsets[neighbour]);
+                    rindex[neighbour] = index++;
+                    root[neighbour] = true;
+                }
+                else if(rindex[neighbour] < rindex[curr])
+                {
+                    rindex[curr] = rindex[neighbour];
+                    root[curr] = false;
+                }
+                continue;
+            }
+
+            callStack.pop_back();
+            edgeIndex.pop_back();
+
+            if(root[curr])
+            {
+                index--;
+                while(!componentStack.empty() && rindex[curr] <= rindex[componentStack.back()])
+                {
+                    rindex[componentStack.back()] = componentNo;
+                    representative[componentStack.back()] = curr;
+                    componentStack.pop_back();
+                    index--;
+                }
+                rindex[curr] = componentNo--;
+                representative[curr] = curr;
+            }
+            else
+            {
+                componentStack.push_back(curr);
+            }
+
+            if(!callStack.empty())
+            {
+                int parent = callStack.back();
+                if(rindex[curr] < rindex[parent])
+                {
+                    rindex[parent] = rindex[curr];
+                    root[parent] = false;
+                }
+            }
+        }
+    }
+}
+
+int DiGraph::groupVertices(const vector<int>& label, vector<int>& vertices, vector<pair<int, int> >& groups)
+{
+    int noGroups = 0;
+    for(int i=0;i<noVertices;i++)
+    {
+        noGroups = max(noGroups, label[i] + 1);
+    }
+
+    vector<int> offsets(noGroups + 1, 0);
+    for(int i=0;i<noVertices;i++)
+    {
+        if(label[i] != LABEL_DONE)
+        {
+            offsets[label[i] + 1]++;
+        }
+    }
+    for(int i=0;i<noGroups;i++)
+    {
+        offsets[i+1] += offsets[i];
+    }
+
+    vertices.resize(offsets[noGroups]);
+    vector<int> position(offsets.begin(), offsets.end() - 1);
+    for(int i=0;i<noVertices;i++)
+    {
+        if(label[i] != LABEL_DONE)
+        {
+            vertices[position[label[i]]++] = i;
+        }
+    }
+
+    groups.clear();
+    for(int i=0;i<noGroups;i++)
+    {
+        if(offsets[i] < offsets[i+1])
+        {
+            groups.push_back(make_pair(offsets[i], offsets[i+1]));
+        }
+    }
+
+    return noGroups;
+}
+
+template<class Adjacency>
+void DiGraph::dcscVisitor(int curr, const Adjacency& adjSet, vector<int>& label, int fromLabel, int toLabel,
+    int sharedLabel, int sccLabel, vector<int>& dfsHelper)
+{
+    dfsHelper.push_back(curr);
+    while(!dfsHelper.empty())
+    {
+        curr = dfsHelper.back();
+        dfsHelper.pop_back();
+
+        for(int neighbour : adjSet.neighbours(curr))
+        {
+            if(label[neighbour] == fromLabel)
+            {
+                label[neighbour] = toLabel;
+                dfsHelper.push_back(neighbour);
+            }
+            else if(label[neighbour] == sharedLabel)
+            {
+                label[neighbour] = sccLabel;
+                dfsHelper.push_back(neighbour);
+            }
+        }
+    }
+}
+
+template<class Adjacency>
+void DiGraph::sweepVisitor(int curr, const Adjacency& adjSet, const Adjacency& reverseSet, vector<int>& label,
+    int fromLabel, int toLabel, int sharedLabel, int sccLabel, const int* subGraph, int subGraphSize,
+    SweepBuffers& buffers)
+{
+    vector<int>& frontier = buffers.frontier;
+    vector<int>& next = buffers.next;
+    vector<uint64_t>& frontierBits = buffers.frontierBits;
+    vector<uint64_t>& unvisitedBits = buffers.unvisitedBits;
+
+    auto unreached = [&](int v) { return label[v] == fromLabel || label[v] == sharedLabel; };
+    auto reach = [&](int v) { label[v] = label[v] == fromLabel ? toLabel : sccLabel; };
+    auto degree = [&](int v) { return adjSet.degree(v); };
+
+    /*
+     * The edges left to the unreached vertices are estimated from the average degree, and
+     * by their out-degrees in place of their in-degrees, so that neither a pass over the
+     * sub-graph nor reads of the reverse adjacency are needed while the search is top-down.
+     */
+    long long unvisitedEdges = (long long)subGraphSize * countEdges(adjSet, noVertices) / max(noVertices, 1);
+    long long frontierEdges = degree(curr);
+
+    if(frontierBits.empty())
+    {
+        frontierBits.assign(((long long)noVertices + 63) / 64, 0);
+    }
+    frontier.assign(1, curr);
+    bool bottomUp = false;
+    while(!frontier.empty())
+    {
+        if(!bottomUp && frontierEdges * SWEEP_ALPHA > unvisitedEdges)
+        {
+            bottomUp = true;
+            unvisitedBits.assign((subGraphSize + 63) / 64, 0);
+            for(int i=0;i<subGraphSize;i++)
+            {
+                if(unreached(subGraph[i]))
+                {
+                    unvisitedBits[i >> 6] |= 1ULL << (i & 63);
+                }
+            }
+        }
+        else if(bottomUp && (long long)frontier.size() * SWEEP_BETA < subGraphSize)
+        {
+            bottomUp = false;
+        }
+
+        unvisitedEdges -= frontierEdges;
+        frontierEdges = 0;
+        next.clear();
+        if(!bottomUp)
+        {
+            for(auto vertex : frontier)
+            {
+                for(int neighbour : adjSet.neighbours(vertex))
+                {
+                    if(unreached(neighbour))
+                    {
+                        reach(neighbour);
+                        frontierEdges += degree(neighbour);
+                        next.push_back(neighbour);
+                    }
+                }
+            }
+        }
+        else
+        {
+            for(auto vertex : frontier)
+            {
+                frontierBits[vertex >> 6] |= 1ULL << (vertex & 63);
+            }
+
+            for(size_t word=0;word<unvisitedBits.size();word++)
+            {
+                uint64_t bits = unvisitedBits[word];
+                while(bits)
+                {
+                    int bit = __builtin_ctzll(bits);
+                    bits &= bits - 1;
+
+                    int vertex = subGraph[(word << 6) + bit];
+                    if(!unreached(vertex))
+                    {
+                        unvisitedBits[word] &= ~(1ULL << bit);
+                        continue;
+                    }
+
+                    for(int parent : reverseSet.neighbours(vertex))
+                    {
+                        if(frontierBits[parent >> 6] >> (parent & 63) & 1)
+                        {
+                            reach(vertex);
+                            frontierEdges += degree(vertex);
+                            unvisitedBits[word] &= ~(1ULL << bit);
+                            next.push_back(vertex);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            for(auto vertex : frontier)
+            {
+                frontierBits[vertex >> 6] = 0;
+            }
+        }
+
+        frontier.swap(next);
+    }
+}
+
+template<class Adjacency>
+void DiGraph::dcsc(const Adjacency& forward, const Adjacency& reverse, vector<int>& label, vector<int>& representative)
+{
+    PERF_REGION("dcsc");
+    vector<int> vertices, dfsHelper;
+    vector<pair<int, int> > worklist;
+    int nextLabel = groupVertices(label, vertices, worklist);
+    SweepBuffers buffers;
+
+    while(!worklist.empty())
+    {
+        int begin = worklist.back().first, end = worklist.back().second;
+        worklist.pop_back();
+
+        int curr = vertices[begin];
+        int subLabel = label[curr], descLabel = nextLabel++, predLabel = nextLabel++;
+
+        label[curr] = descLabel;
+        if(end - begin >= SWEEP_SUBGRAPH)
+        {
+            PERF_REGION("dcsc:large-subgraph-sweeps");
+            sweepVisitor(curr, forward, reverse, label, subLabel, descLabel, LABEL_NONE, LABEL_NONE,
+                vertices.data() + begin, end - begin, buffers);
+            label[curr] = LABEL_DONE;
+            sweepVisitor(curr, reverse, forward, label, subLabel, predLabel, descLabel, LABEL_DONE,
+                vertices.data() + begin, end - begin, buffers);
+        }
+        else
+        {
+            dcscVisitor(curr, forward, label, subLabel, descLabel, LABEL_NONE, LABEL_NONE, dfsHelper);
+            label[curr] = LABEL_DONE;
+            dcscVisitor(curr, reverse, label, subLabel, predLabel, descLabel, LABEL_DONE, dfsHelper);
+        }
+
+        /*
+         * Partition the range into the component, the remaining descendents,
+         * the remaining predecessors and the unreached vertices.
+         */
+        vector<int>::iterator first = vertices.begin() + begin, last = vertices.begin() + end;
+        vector<int>::iterator descBegin = partition(first, last, [&](int v) { return label[v] == LABEL_DONE; });
+        vector<int>::iterator predBegin = partition(descBegin, last, [&](int v) { return label[v] == descLabel; });
+        vector<int>::iterator restBegin = partition(predBegin, last, [&](int v) { return label[v] == predLabel; });
+
+        for(vector<int>::iterator vertex=first;vertex!=descBegin;vertex++)
+        {
+            representative[*vertex] = curr;
+        }
+
+        int descIndex = descBegin - vertices.begin();
+        int predIndex = predBegin - vertices.begin();
+        int restIndex = restBegin - vertices.begin();
+        if(restIndex < end)
+        {
+            worklist.push_back(make_pair(restIndex, end));
+        }
+        if(descIndex < predIndex)
+        {
+            worklist.push_back(make_pair(descIndex, predIndex));
+        }
+        if(predIndex < restIndex)
+        {
+            worklist.push_back(make_pair(predIndex, restIndex));
+        }
+    }
+}
+
+void DiGraph::parallelDcscVisitor(int curr, const CSRAdjacency& adjSet, vector<atomic<int> >& label,
+    int fromLabel, int toLabel, int sharedLabel, int sccLabel, ThreadPool& pool)
+{
+    auto claim = [&](int neighbour, vector<int>& next)
+    {
+        int expected = fromLabel;
+        if(label[neighbour].compare_exchange_strong(expected, toLabel, memory_order_relaxed))
+        {
+            next.push_back(neighbour);
+        }
+        else if(expected == sharedLabel && sharedLabel != LABEL_NONE &&
+            label[neighbour].compare_exchange_strong(expected, sccLabel, memory_order_relaxed))
+        {
+            next.push_back(neighbour);
+        }
+    };
+
+    vector<int> frontier(1, curr), next;
+    while(!frontier.empty())
+    {
+        next.clear();
+        if(pool.size() == 1 || frontier.size() < PARALLEL_FRONTIER)
+        {
+            for(auto vertex : frontier)
+            {
+                for(int i=adjSet.offsets[vertex];i<adjSet.offsets[vertex+1];i++)
+                {
+                    claim(adjSet.targets[i], next);
+                }
+            }
+        }
+        else
+        {
+            int grain = PARALLEL_FRONTIER / 4;
+            vector<vector<int> > partial((frontier.size() + grain - 1) / grain);
+            pool.parallelFor(0, frontier.size(), grain, [&](int begin, int end)
+            {
+                vector<int>& local = partial[begin / grain];
+                for(int j=begin;j<end;j++)
+                {
+                    int vertex = frontier[j];
+                    for(int i=adjSet.offsets[vertex];i<adjSet.offsets[vertex+1];i++)
+                    {
+                        claim(adjSet.targets[i], local);
+                    }
+                }
+            });
+            for(auto& local : partial)
+            {
+                next.insert(next.end(), local.begin(), local.end());
+            }
+        }
+        frontier.swap(next);
+    }
+}
+
+void DiGraph::parallelDcsc(const vector<int>& initialLabel, vector<int>& representative)
+{
+    PERF_REGION("pdcsc");
+    ThreadPool pool(noThreads);
+
+    vector<int> vertices;
+    vector<pair<int, int> > groups;
+    atomic<int> nextLabel(groupVertices(initialLabel, vertices, groups));
+
+    vector<atomic<int> > label(noVertices);
+    pool.parallelFor(0, noVertices, 1 << 16, [&](int begin, int end)
+    {
+        for(int i=begin;i<end;i++)
+        {
+            label[i].store(initialLabel[i], memory_order_relaxed);
+        }
+    });
+
+
+    TaskGroup group;
+    function<void(int, int)> solve = [&](int begin, int end)
+    {
+        vector<pair<int, int> > worklist(1, make_pair(begin, end));
+        while(!worklist.empty())
+        {
+            begin = worklist.back().first;
+            end = worklist.back().second;
+            worklist.pop_back();
+
+            int curr = vertices[begin];
+            int subLabel = label[curr].load(memory_order_relaxed);
+            int descLabel = nextLabel++, predLabel = nextLabel++;
+
+            label[curr].store(descLabel, memory_order_relaxed);
+            parallelDcscVisitor(curr, adj, label, subLabel, descLabel, LABEL_NONE, LABEL_NONE, pool);
+            label[curr].store(LABEL_DONE, memory_order_relaxed);
+            parallelDcscVisitor(curr, transposeAdj, label, subLabel, predLabel, descLabel, LABEL_DONE, pool);
+
+            auto labelOf = [&](int v) { return label[v].load(memory_order_relaxed); };
+            vector<int>::iterator first = vertices.begin() + begin, last = vertices.begin() + end;
+            vector<int>::iterator descBegin = partition(first, last, [&](int v) { return labelOf(v) == LABEL_DONE; });
+            vector<int>::iterator predBegin = partition(descBegin, last, [&](int v) { return labelOf(v) == descLabel; });
+            vector<int>::iterator restBegin = partition(predBegin, last, [&](int v) { return labelOf(v) == predLabel; });
+
+            int descIndex = descBegin - vertices.begin();
+            int predIndex = predBegin - vertices.begin();
+            int restIndex = restBegin - vertices.begin();
+            for(int i=begin;i<descIndex;i++)
+            {
+                representative[vertices[i]] = curr;
+            }
+
+            pair<int, int> subGraphs[3] = {
+                make_pair(restIndex, end), make_pair(descIndex, predIndex), make_pair(predIndex, restIndex)
+            };
+            for(auto& subGraph : subGraphs)
+            {
+                if(subGraph.second - subGraph.first >= PARALLEL_SPAWN)
+                {
+                    pool.submit(group, [&solve, subGraph] { solve(subGraph.first, subGraph.second); });
+                }
+                else if(subGraph.first < subGraph.second)
+                {
+                    worklist.push_back(subGraph);
+                }
+            }
+        }
+    };
+
+    for(auto& subGraph : groups)
+    {
+        pool.submit(group, [&solve, subGraph] { solve(subGraph.first, subGraph.second); });
+    }
+    pool.wait(group);
+}
+
+void DiGraph::colorPropagation(vector<int>& label, vector<int>& representative)
+{
+    ThreadPool pool(noThreads);
+    int grain = 1 << 12;
+
+    vector<int> remaining, next(noVertices, LABEL_DONE);
+    vector<atomic<int> > color(noVertices);
+    for(int i=0;i<noVertices;i++)
+    {
+        color[i].store(LABEL_DONE, memory_order_relaxed);
+        if(label[i] != LABEL_DONE)
+        {
+            remaining.push_back(i);
+        }
+    }
+
+    while(!remaining.empty())
+    {
+        int noRemaining = remaining.size();
+        pool.parallelFor(0, noRemaining, grain, [&](int begin, int end)
+        {
+            for(int j=begin;j<end;j++)
+            {
+                color[remaining[j]].store(remaining[j], memory_order_relaxed);
+            }
+        });
+
+        {
+            PERF_REGION("color:propagate");
+            atomic<bool> changed(true);
+            while(changed)
+            {
+                changed = false;
+                pool.parallelFor(0, noRemaining, grain, [&](int begin, int end)
+                {
+                    bool localChange = false;
+                    for(int j=begin;j<end;j++)
+                    {
+                        int vertex = remaining[j], best = color[vertex].load(memory_order_relaxed);
+                        for(int i=transposeAdj.offsets[vertex];i<transposeAdj.offsets[vertex+1];i++)
+                        {
+                            int neighbour = transposeAdj.targets[i];
+                            if(label[neighbour] == label[vertex])
+                            {
+                                best = max(best, color[neighbour].load(memory_order_relaxed));
+                            }
+                        }
+                        next[vertex] = best;
+                        localChange |= best != color[vertex].load(memory_order_relaxed);
+                    }
+                    if(localChange)
+                    {
+                        changed = true;
+                    }
+                });
+                pool.parallelFor(0, noRemaining, grain, [&](int begin, int end)
+                {
+                    for(int j=begin;j<end;j++)
+                    {
+                        color[remaining[j]].store(next[remaining[j]], memory_order_relaxed);
+                    }
+                });
+            }
+        }
+
+        /*
+         * Every vertex keeping its own colour is the root of a component made of the
+         * vertices of its colour that reach it. The colours partition the vertices, so
+         * the backward searches from the roots are independent.
+         */
+        PERF_REGION("color:backward-search");
+        vector<int> roots;
+        for(auto vertex : remaining)
+        {
+            if(color[vertex].load(memory_order_relaxed) == vertex)
+            {
+                roots.push_back(vertex);
+            }
+        }
+
+        pool.parallelFor(0, roots.size(), 64, [&](int begin, int end)
+        {
+            vector<int> dfsHelper;
+            for(int j=begin;j<end;j++)
+            {
+                int root = roots[j];
+
+                representative[root] = root;
+                color[root].store(LABEL_DONE, memory_order_relaxed);
+                dfsHelper.push_back(root);
+                while(!dfsHelper.empty())
+                {
+                    int curr = dfsHelper.back();
+                    dfsHelper.pop_back();
+
+                    for(int i=transposeAdj.offsets[curr];i<transposeAdj.offsets[curr+1];i++)
+                    {
+                        int neighbour = transposeAdj.targets[i];
+                        if(color[neighbour].load(memory_order_relaxed) == root)
+                        {
+                            color[neighbour].store(LABEL_DONE, memory_order_relaxed);
+                            representative[neighbour] = root;
+                            dfsHelper.push_back(neighbour);
+                        }
+                    }
+                }
+            }
+        });
+
+        vector<int> stillRemaining;
+        for(auto vertex : remaining)
+        {
+            if(color[vertex].load(memory_order_relaxed) == LABEL_DONE)
+            {
+                label[vertex] = LABEL_DONE;
+            }
+            else
+            {
+                stillRemaining.push_back(vertex);
+            }
+        }
+        remaining.swap(stillRemaining);
+    }
+}
+
+void DiGraph::multistepPreprocess(vector<int>& finalLabel, vector<int>& representative)
+{
+    ThreadPool pool(noThreads);
+    int grain = 1 << 12;
+
+    vector<atomic<int> > label(noVertices), inDegree(noVertices), outDegree(noVertices);
+    pool.parallelFor(0, noVertices, grain, [&](int begin, int end)
+    {
+        for(int i=begin;i<end;i++)
+        {
+            label[i].store(0, memory_order_relaxed);
+            inDegree[i].store(transposeAdj.offsets[i+1] - transposeAdj.offsets[i], memory_order_relaxed);
+            outDegree[i].store(adj.offsets[i+1] - adj.offsets[i], memory_order_relaxed);
+        }
+    });
+
+    /*
+     * Trim vertices with no incoming or no outgoing edges, round by round, since
+     * each of them is a component by itself. Removing a vertex lowers the degrees
+     * of its neighbours, which may make them trimmable in the next round.
+     */
+    auto trim = [&](int vertex, vector<int>& trimmed)
+    {
+        int expected = 0;
+        if(label[vertex].compare_exchange_strong(expected, LABEL_DONE, memory_order_relaxed))
+        {
+            trimmed.push_back(vertex);
+        }
+    };
+
+    vector<int> frontier, trimmedVertices;
+    vector<vector<int> > partial((noVertices + grain - 1) / grain);
+    {
+        PERF_REGION("multistep:trim");
+        pool.parallelFor(0, noVertices, grain, [&](int begin, int end)
+        {
+            for(int i=begin;i<end;i++)
+            {
+                if(!inDegree[i].load(memory_order_relaxed) || !outDegree[i].load(memory_order_relaxed))
+                {
+                    trim(i, partial[begin / grain]);
+                }
+            }
+        });
+        for(auto& local : partial)
+        {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+        }
+
+        while(!frontier.empty())
+        {
+            trimmedVertices.insert(trimmedVertices.end(), frontier.begin(), frontier.end());
+
+            partial.assign((frontier.size() + grain - 1) / grain, vector<int>());
+            pool.parallelFor(0, frontier.size(), grain, [&](int begin, int end)
+            {
+                vector<int>& local = partial[begin / grain];
+                for(int j=begin;j<end;j++)
+                {
+                    int vertex = frontier[j];
+                    for(int i=adj.offsets[vertex];i<adj.offsets[vertex+1];i++)
+                    {
+                        if(inDegree[adj.targets[i]].fetch_sub(1, memory_order_relaxed) == 1)
+                        {
+                            trim(adj.targets[i], local);
+                        }
+                    }
+                    for(int i=transposeAdj.offsets[vertex];i<transposeAdj.offsets[vertex+1];i++)
+                    {
+                        if(outDegree[transposeAdj.targets[i]].fetch_sub(1, memory_order_relaxed) == 1)
+                        {
+                            trim(transposeAdj.targets[i], local);
+                        }
+                    }
+                }
+            });
+
+            frontier.clear();
+            for(auto& local : partial)
+            {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+            }
+        }
+    }
+
+    for(auto vertex : trimmedVertices)
+    {
+        representative[vertex] = vertex;
+    }
+
+    /*
+     * Find the giant component with a single FW-BW search from the vertex with
+     * the largest product of remaining in and out degrees.
+     */
+    int pivot = -1;
+    long long pivotDegree = -1;
+    for(int i=0;i<noVertices;i++)
+    {
+        long long degree = (long long)inDegree[i].load(memory_order_relaxed) * outDegree[i].load(memory_order_relaxed);
+        if(label[i].load(memory_order_relaxed) != LABEL_DONE && degree > pivotDegree)
+        {
+            pivot = i;
+            pivotDegree = degree;
+        }
+    }
+
+    if(pivot == -1)
+    {
+        for(int i=0;i<noVertices;i++)
+        {
+            finalLabel[i] = LABEL_DONE;
+        }
+        return;
+    }
+
+    {
+        PERF_REGION("multistep:giant-component");
+        int descLabel = 1, predLabel = 2, sccLabel = 3;
+        label[pivot].store(descLabel, memory_order_relaxed);
+        parallelDcscVisitor(pivot, adj, label, 0, descLabel, LABEL_NONE, LABEL_NONE, pool);
+        label[pivot].store(sccLabel, memory_order_relaxed);
+        parallelDcscVisitor(pivot, transposeAdj, label, 0, predLabel, descLabel, sccLabel, pool);
+
+        for(int i=0;i<noVertices;i++)
+        {
+            finalLabel[i] = label[i].load(memory_order_relaxed);
+            if(finalLabel[i] == sccLabel)
+            {
+                representative[i] = pivot;
+                finalLabel[i] = LABEL_DONE;
+            }
+        }
+    }
+
+    /*
+     * Split the rest of the vertices into the weakly connected components of the
+     * sub-graphs left by the FW-BW search, which are solved independently.
+     */
+    PERF_REGION("multistep:split");
+    vector<int> group(noVertices, LABEL_NONE), bfsHelper;
+    int noGroups = 0;
+    for(int start=0;start<noVertices;start++)
+    {
+        if(finalLabel[start] == LABEL_DONE || group[start] != LABEL_NONE)
+        {
+            continue;
+        }
+
+        int size = 0;
+        group[start] = noGroups;
+        bfsHelper.push_back(start);
+        while(!bfsHelper.empty())
+        {
+            int curr = bfsHelper.back();
+            bfsHelper.pop_back();
+            size++;
+
+            const CSRAdjacency* adjSets[2] = {&adj, &transposeAdj};
+            for(auto adjSet : adjSets)
+            {
+                for(int i=adjSet->offsets[curr];i<adjSet->offsets[curr+1];i++)
+                {
+                    int neighbour = adjSet->targets[i];
+                    if(finalLabel[neighbour] == finalLabel[curr] && group[neighbour] == LABEL_NONE)
+                    {
+                        group[neighbour] = noGroups;
+                        bfsHelper.push_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        if(size == 1)
+        {
+            representative[start] = start;
+            group[start] = LABEL_DONE;
+        }
+        else
+        {
+            noGroups++;
+        }
+    }
+
+    for(int i=0;i<noVertices;i++)
+    {
+        finalLabel[i] = finalLabel[i] == LABEL_DONE ? LABEL_DONE : group[i];
+    }
+}
+
+void collectComponents(int noVertices, const vector<int>& representative, SccResult& result)
+{
+    PERF_REGION("components");
+    vector<int>& componentOf = result.componentOf;
+    componentOf.assign(noVertices, -1);
+
+    /*
+     * Number the components in the order in which their smallest vertex is met, keeping the
+     * number given to every representative.
+     */
+    int noComponents = 0;
+    vector<int> number(noVertices, -1);
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        int& id = number[representative[vertex]];
+        if(id == -1)
+        {
+            id = noComponents++;
+        }
+        componentOf[vertex] = id;
+    }
+
+    result.offsets.assign(noComponents + 1, 0);
+    for(auto id : componentOf)
+    {
+        result.offsets[id+1]++;
+    }
+
+    result.noComponents = noComponents;
+    result.maxComponentSize = 0;
+    result.largestComponent = -1;
+    result.noSingletons = 0;
+    for(int id=0;id<noComponents;id++)
+    {
+        int size = result.offsets[id+1];
+        if(size > result.maxComponentSize)
+        {
+            result.maxComponentSize = size;
+            result.largestComponent = id;
+        }
+        result.noSingletons += size == 1;
+        result.offsets[id+1] += result.offsets[id];
+    }
+
+    result.vertices.resize(noVertices);
+    vector<int> position(result.offsets.begin(), result.offsets.end() - 1);
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        result.vertices[position[componentOf[vertex]]++] = vertex;
+    }
+}
+
+void DiGraph::findRepresentatives(ALG_TYPE alg, vector<int>& representative)
+{
+    representative.assign(noVertices, -1);
+    if(incremental)
+    {
+        for(int vertex=0;vertex<noVertices;vertex++)
+        {
+            representative[vertex] = findComponent(vertex);
+        }
+        return;
+    }
+
+    vector<int> label(noVertices, 0);
+
+    bool useCompressed = compressed && !multistep && (alg == ALG_DFS || alg == ALG_DCSC);
+    if(useCompressed)
+    {
+        compressAdjacency();
+    }
+    else if(alg == ALG_TARJAN)
+    {
+        buildAdjacency();
+    }
+    else
+    {
+        buildTranspose();
+    }
+
+    if(multistep)
+    {
+        buildTranspose();
+        multistepPreprocess(label, representative);
+    }
+
+    if(alg == ALG_DFS && useCompressed)
+    {
+        dfs(compressedAdj, compressedTranspose, label, representative);
+    }
+    else if(alg == ALG_DFS)
+    {
+        dfs(adj, transposeAdj, label, representative);
+    }
+    else if(alg == ALG_TARJAN)
+    {
+        tarjan(label, representative);
+    }
+    else if(alg == ALG_PARALLEL_DCSC)
+    {
+        parallelDcsc(label, representative);
+    }
+    else if(alg == ALG_COLOR)
+    {
+        colorPropagation(label, representative);
+    }
+    else if(useCompressed)
+    {
+        dcsc(compressedAdj, compressedTranspose, label, representative);
+    }
+    else
+    {
+        dcsc(adj, transposeAdj, label, representative);
+    }
+}
+
+SccResult DiGraph::getComponentLabels(ALG_TYPE alg)
+{
+    vector<int> representative;
+    findRepresentatives(alg, representative);
+
+    if(!vertexOrder.empty())
+    {
+        vector<int> original(noVertices);
+        for(int vertex=0;vertex<noVertices;vertex++)
+        {
+            original[vertex] = vertexOrigin[representative[vertexOrder[vertex]]];
+        }
+        representative.swap(original);
+    }
 
+    SccResult result;
+    collectComponents(noVertices, representative, result);
 
-DiGraph::DiGraph(int noVertices) : adj(noVertices)
-{
-    this->noVertices = noVertices;
+    return result;
 }
 
-void DiGraph::addEdge(int x, int y)
+vector<vector<int> > DiGraph::getStronglyConnectedComponents(ALG_TYPE alg)
 {
-    adj[x].push_back(y);
+    SccResult result = getComponentLabels(alg);
+
+    vector<vector<int> > components(result.noComponents);
+    for(int id=0;id<result.noComponents;id++)
+    {
+        components[id].assign(result.vertices.begin() + result.offsets[id], result.vertices.begin() + result.offsets[id+1]);
+    }
+
+    return components;
 }
 
-vector<vector<int> > DiGraph::getTranspose()
+void DiGraph::startIncremental(ALG_TYPE alg)
 {
-    vector<vector<int> > transposeAdj(noVertices);
+    incremental = false;
+    vector<int> representative;
+    findRepresentatives(alg, representative);
+    SccResult result;
+    collectComponents(noVertices, representative, result);
+    const CSRAdjacency& adjacency = getAdjacency();
+
+    noComponents = result.noComponents;
+    componentParent.resize(noVertices);
+    componentSize.assign(noVertices, 0);
+    for(int id=0;id<noComponents;id++)
+    {
+        int root = result.vertices[result.offsets[id]];
+        componentSize[root] = result.offsets[id+1] - result.offsets[id];
+        for(int i=result.offsets[id];i<result.offsets[id+1];i++)
+        {
+            componentParent[result.vertices[i]] = root;
+        }
+    }
 
+    vector<vector<int> >(noVertices).swap(componentOut);
+    vector<vector<int> >(noVertices).swap(componentIn);
+    vector<int> inDegree(noComponents, 0);
     for(int x=0;x<noVertices;x++)
     {
-        for(auto y : adj[x])
+        for(int i=adjacency.offsets[x];i<adjacency.offsets[x+1];i++)
+        {
+            int y = adjacency.targets[i];
+            if(result.componentOf[x] != result.componentOf[y])
+            {
+                componentOut[componentParent[x]].push_back(y);
+                componentIn[componentParent[y]].push_back(x);
+                inDegree[result.componentOf[y]]++;
+            }
+        }
+    }
+
+    /*
+     * Kahn's algorithm on the condensation gives the initial topological order.
+     */
+    topoOrder.assign(noVertices, 0);
+    vector<int> ready;
+    for(int id=0;id<noComponents;id++)
+    {
+        if(inDegree[id] == 0)
+        {
+            ready.push_back(id);
+        }
+    }
+    int position = 0;
+    while(!ready.empty())
+    {
+        int id = ready.back();
+        ready.pop_back();
+
+        int root = result.vertices[result.offsets[id]];
+        topoOrder[root] = position++;
+        for(auto y : componentOut[root])
         {
-            transposeAdj[y].push_back(x);
+            if(--inDegree[result.componentOf[y]] == 0)
+            {
+                ready.push_back(result.componentOf[y]);
+            }
         }
     }
 
-    return transposeAdj;
+    forwardMark.assign(noVertices, 0);
+    backwardMark.assign(noVertices, 0);
+    searchStamp = 0;
+
+    incrementalAlg = alg;
+    incremental = true;
+}
+
+void DiGraph::stopIncremental()
+{
+    incremental = false;
+    noComponents = 0;
+    vector<int>().swap(componentParent);
+    vector<int>().swap(componentSize);
+    vector<int>().swap(topoOrder);
+    vector<vector<int> >().swap(componentOut);
+    vector<vector<int> >().swap(componentIn);
+    vector<int>().swap(forwardMark);
+    vector<int>().swap(backwardMark);
 }
 
-void DiGraph::fillStack(int curr, vector<bool>& visited, stack<int>& visitOrder)
+int DiGraph::getComponent(int vertex)
 {
-    if(visited[curr])
+    if(vertexOrder.empty())
     {
-        return;
+        return findComponent(vertex);
     }
+    return vertexOrigin[findComponent(vertexOrder[vertex])];
+}
+
+int DiGraph::getNoComponents()
+{
+    return noComponents;
+}
 
-    visited[curr] = true;
-    for(auto neighbour : adj[curr])
+int DiGraph::findComponent(int vertex)
+{
+    while(componentParent[vertex] != vertex)
     {
-        fillStack(neighbour, visited, visitOrder);
+        componentParent[vertex] = componentParent[componentParent[vertex]];
+        vertex = componentParent[vertex];
     }
-    visitOrder.push(curr);
+    return vertex;
 }
 
-vector<vector<int> > DiGraph::dfs()
+void DiGraph::boundedSearch(int start, bool forward, int bound, vector<int>& visited)
 {
-    vector<vector<int> > components;
-    vector<bool> visited(noVertices);
+    vector<int>& mark = forward ? forwardMark : backwardMark;
+    vector<vector<int> >& edges = forward ? componentOut : componentIn;
 
-    stack<int> visitOrder, dfsHelper;
-    for(int i=0;i<noVertices;i++)
+    visited.assign(1, start);
+    mark[start] = searchStamp;
+    for(size_t next=0;next<visited.size();next++)
+    {
+        int curr = visited[next];
+        for(auto vertex : edges[curr])
+        {
+            int component = findComponent(vertex);
+            if(mark[component] == searchStamp || (forward ? topoOrder[component] > bound : topoOrder[component] < bound))
+            {
+                continue;
+            }
+
+            mark[component] = searchStamp;
+            visited.push_back(component);
+        }
+    }
+}
+
+void DiGraph::insertEdge(int x, int y)
+{
+    int cx = findComponent(x), cy = findComponent(y);
+    if(cx == cy)
     {
-        fillStack(i, visited, visitOrder);
+        return;
     }
 
-    fill(visited.begin(), visited.end(), false);
-    while(!visitOrder.empty())
+    componentOut[cx].push_back(y);
+    componentIn[cy].push_back(x);
+    if(topoOrder[cx] < topoOrder[cy])
     {
-        int curr = visitOrder.top();
-        visitOrder.pop();
+        return;
+    }
 
-        if(visited[curr])
+    searchStamp++;
+    vector<int> reached, reaching;
+    boundedSearch(cy, true, topoOrder[cx], reached);
+    boundedSearch(cx, false, topoOrder[cy], reaching);
+
+    /*
+     * The components reached from cy and reaching cx lie on a cycle closed by the edge.
+     * They are merged into the largest of them, and the searched components are given
+     * their old positions again, those reaching cx first, then the merged component,
+     * then those reached from cy.
+     */
+    vector<int> positions, before, after, cycle;
+    for(auto component : reaching)
+    {
+        positions.push_back(topoOrder[component]);
+        (forwardMark[component] == searchStamp ? cycle : before).push_back(component);
+    }
+    for(auto component : reached)
+    {
+        if(backwardMark[component] != searchStamp)
         {
-            continue;
+            positions.push_back(topoOrder[component]);
+            after.push_back(component);
         }
+    }
 
-        vector<int> component;
+    auto byPosition = [this](int a, int b) { return topoOrder[a] < topoOrder[b]; };
+    sort(positions.begin(), positions.end());
+    sort(before.begin(), before.end(), byPosition);
+    sort(after.begin(), after.end(), byPosition);
 
-        dfsHelper.push(curr);
-        visited[curr] = true;
-        while(!dfsHelper.empty())
-        {
-            curr = dfsHelper.top();
-            dfsHelper.pop();
+    int next = 0;
+    for(auto component : before)
+    {
+        topoOrder[component] = positions[next++];
+    }
 
-            component.push_back(curr);
+    if(!cycle.empty())
+    {
+        int root = cycle[0];
+        for(auto component : cycle)
+        {
+            if(componentOut[component].size() + componentIn[component].size() >
+                componentOut[root].size() + componentIn[root].size())
+            {
+                root = component;
+            }
+        }
 
-            for(auto neighbour : transposeAdj[curr])
+        for(auto component : cycle)
+        {
+            if(component == root)
             {
-                if(!visited[neighbour])
-                {
-                    visited[neighbour] = true;
-                    dfsHelper.push(neighbour);
-                }
+                continue;
             }
+
+            componentParent[component] = root;
+            componentSize[root] += componentSize[component];
+            componentOut[root].insert(componentOut[root].end(), componentOut[component].begin(), componentOut[component].end());
+            componentIn[root].insert(componentIn[root].end(), componentIn[component].begin(), componentIn[component].end());
+            vector<int>().swap(componentOut[component]);
+            vector<int>().swap(componentIn[component]);
+        }
+        noComponents -= cycle.size() - 1;
+        topoOrder[root] = positions[next++];
+
+        for(auto edges : {&componentOut[root], &componentIn[root]})
+        {
+            edges->erase(remove_if(edges->begin(), edges->end(),
+                [this, root](int vertex) { return findComponent(vertex) == root; }), edges->end());
         }
-        components.push_back(component);
     }
 
-    return components;
+    next = positions.size() - after.size();
+    for(auto component : after)
+    {
+        topoOrder[component] = positions[next++];
+    }
 }
 
-void DiGraph::dcscVisitor(int curr, vector<bool>& visited, vector<bool>& done, vector<vector<int> >& adjSet)
+bool loadGraphInput(const char* fileName, bool cache, int noThreads, GraphInput& input, string& errorMsg)
 {
-    stack<int> dfsHelper;
-
-    dfsHelper.push(curr);
-    visited[curr] = true;
-    while(!dfsHelper.empty())
+    string snapshotFile = findSnapshot(fileName, cache);
+    input.fromSnapshot = !snapshotFile.empty();
+    if(input.fromSnapshot)
     {
-        curr = dfsHelper.top();
-        dfsHelper.pop();
+        if(!input.snapshot.open(snapshotFile.c_str(), SNAPSHOT_DIGRAPH))
+        {
+            errorMsg = "Invalid graph snapshot.";
+            return false;
+        }
+        input.header = input.snapshot.header();
+        input.originalIds = input.snapshot.values();
+        input.graphSize = input.snapshot.noRows();
 
-        for(auto neighbour : adjSet[curr])
+        input.noMappedIds = 0;
+        while(input.noMappedIds < input.graphSize &&
+            (!input.noMappedIds || input.originalIds[input.noMappedIds] > input.originalIds[input.noMappedIds-1]))
         {
-            if(!visited[neighbour] && !done[neighbour])
-            {
-                visited[neighbour] = true;
-                dfsHelper.push(neighbour);
-            }
+            input.noMappedIds++;
         }
+        return true;
+    }
+
+    if(!loadEdgeList(fileName, 2, 2, input.edges, noThreads))
+    {
+        errorMsg = "Cannot open graph file.";
+        return false;
     }
+    input.header = input.edges.header;
+    input.noMappedIds = remapVertexIds(input.edges.columns[0], input.edges.columns[1], input.originalIdStorage, noThreads);
+    input.graphSize = max((int)input.header[0], input.noMappedIds);
+    input.originalIds = input.originalIdStorage.data();
+    return true;
 }
 
-void DiGraph::dcsc(vector<int>& vertexSet, vector<bool>& done, vector<vector<int> >& components)
+void buildDiGraph(const char* fileName, bool cache, GraphInput& input, DiGraph& graph)
 {
-    if(vertexSet.empty())
+    if(input.fromSnapshot)
     {
+        graph.setAdjacency(input.snapshot.offsets(), input.snapshot.targets());
         return;
     }
 
-    int curr = vertexSet[0];
+    graph.addEdges(input.edges.columns[0], input.edges.columns[1]);
 
-    vector<bool> pred(noVertices), desc(noVertices);
-    dcscVisitor(curr, pred, done, transposeAdj);
-    dcscVisitor(curr, desc, done, adj);
+    input.originalIdStorage.resize(input.graphSize, 0);
+    input.originalIds = input.originalIdStorage.data();
 
-    vector<int> component;
-    for(auto vertex: vertexSet)
+    if(cache)
     {
-        if(pred[vertex] && desc[vertex])
+        const CSRAdjacency& adjacency = graph.getAdjacency();
+        if(!GraphSnapshot::write(snapshotPath(fileName).c_str(), SNAPSHOT_DIGRAPH, input.header, input.graphSize,
+            adjacency.offsets, adjacency.targets, input.graphSize, input.originalIds))
         {
-            component.push_back(vertex);
-            done[vertex] = true;
+            cerr<<"Warning - Cannot write graph snapshot."<<endl;
         }
     }
-    components.push_back(component);
+}
 
-    vector<int> newVertexSet;
-    for(auto vertex: vertexSet)
+bool solveBatch(char* batchPath, ALG_TYPE alg, char* resultsFile, int noThreads, bool multistep, bool cache, ORDER_TYPE order,
+    bool compress)
+{
+    vector<string> fileNames;
+    if(!listBatchFiles(batchPath, fileNames))
     {
-        if(pred[vertex] && !done[vertex])
-        {
-            newVertexSet.push_back(vertex);
-        }
+        displayError("Cannot list the graphs of the batch.");
     }
-    dcsc(newVertexSet, done, components);
 
-    newVertexSet.clear();
-    for(auto vertex: vertexSet)
+    auto load = [=](const string& fileName, long long& noEdges) -> BatchTask
     {
-        if(desc[vertex] && !done[vertex])
+        shared_ptr<GraphInput> input(new GraphInput());
+        string errorMsg;
+        if(!loadGraphInput(fileName.c_str(), cache, noThreads, *input, errorMsg))
         {
-            newVertexSet.push_back(vertex);
+            reportBatchFailure(fileName, errorMsg);
+            return BatchTask();
         }
-    }
-    dcsc(newVertexSet, done, components);
+        noEdges = input->header[1];
 
-    newVertexSet.clear();
-    for(auto vertex: vertexSet)
-    {
-        if(!pred[vertex] && !desc[vertex] && !done[vertex])
+        return [=](int taskThreads) -> string
         {
-            newVertexSet.push_back(vertex);
-        }
-    }
-    dcsc(newVertexSet, done, components);
+            DiGraph graph(input->graphSize);
+            graph.setNoThreads(taskThreads);
+            graph.setMultistep(multistep);
+            graph.setCompressed(compress);
+            buildDiGraph(fileName.c_str(), cache, *input, graph);
+            if(order != ORDER_NONE)
+            {
+                graph.reorderVertices(order);
+            }
+
+            double start = wallTime();
+            SccResult components = graph.getComponentLabels(alg);
+            double stop = wallTime();
+            double processingTime = stop - start;
+
+            ostringstream line;
+            line<<fileName<<" "<<input->header[0]<<" "<<input->header[1]<<" "<<components.noComponents<<" "
+                <<components.maxComponentSize<<" "<<FIXED_FLOAT(processingTime, 6);
+            return line.str();
+        };
+    };
+
+    return runBatch(fileNames, noThreads, load, resultsFile) == 0;
 }
 
-vector<vector<int> > DiGraph::getStronglyConnectedComponents(ALG_TYPE alg)
+void solveSemiExternal(char* fileName, ALG_TYPE alg, char* resultsFile, int noThreads, bool multistep, bool cache,
+    ORDER_TYPE order, bool compress, long long memoryBudget, OUTPUT_TYPE format, char* outputFile)
 {
-    transposeAdj = getTranspose();
-
-    if(alg == ALG_DFS)
+    SemiExternalScc solver(memoryBudget, noThreads);
+    vector<long long> header;
+    vector<int> originalIds;
+    string errorMsg;
+    if(!solver.open(fileName, cache, header, originalIds, errorMsg))
     {
-        return dfs();
+        displayError(errorMsg);
     }
 
-    vector<int> vertexSet;
-    for(int i=0;i<noVertices;i++)
+    double start = wallTime();
+    SccResult components = solver.getComponentLabels(alg, multistep, compress, order);
+    double stop = wallTime();
+    double processingTime = stop - start;
+
+    cout<<"Graph Info:"<<endl;
+    cout<<"\tVertices - "<<header[0]<<", Edges - "<<header[1]<<endl;
+    cout<<"\tNo. of strongly connected components - "<<components.noComponents<<endl;
+    cout<<"\tNo. of vertices in largest strongly connected component - "<<components.maxComponentSize<<endl;
+    cout<<"\tSemi-external passes - "<<solver.getNoPasses()<<endl;
+    cout<<"\tProcessing time - "<<FIXED_FLOAT(processingTime, 6)<<" seconds"<<endl<<endl;
+
+    if(resultsFile)
     {
-        vertexSet.push_back(i);
+        writeResults(resultsFile, fileName, header[0], header[1], components.noComponents, components.maxComponentSize, processingTime);
     }
-    vector<bool> done(noVertices);
-
-    vector<vector<int> > components;
-    dcsc(vertexSet, done, components);
+    PERF_REPORT(resultsFile, fileName);
 
-    return components;
+    OutputBuffer out;
+    if(outputFile && !out.open(outputFile))
+    {
+        displayError("Cannot open output file.");
+    }
+    writeComponents(out, components, originalIds.data(), format);
 }
 
 inline void displayError(string errorMsg)
 {
     cerr<<"Error - "<<errorMsg<<endl;
-    cerr<<"Usage -\n\t./getScc graphFile alg [resultsFile]"<<endl<<endl;
-    cerr<<"\tgraphFile - file containing information about graph"<<endl;
-    cerr<<"\talg - algorithm to use for getting components (dfs or dcsc)"<<endl;
+    cerr<<"Usage -\n\t./getScc graphFile alg [resultsFile] [--threads n] [--multistep] [--cache] [--batch]"
+        " [--output format] [--output-file outputFile] [--queries queryFile] [--order order] [--compress]"
+        " [--memory megabytes] [--insert insertFile]"<<endl<<endl;
+    cerr<<"\tgraphFile - file containing information about graph, as text or a binary snapshot"<<endl;
+    cerr<<"\talg - algorithm to use for getting components (dfs, dcsc, tarjan, pdcsc or color)"<<endl;
     cerr<<"\tresultsFile - optional file for writing back results"<<endl;
+    cerr<<"\t--threads n - number of threads used by parallel algorithms (defaults to all cores)"<<endl;
+    cerr<<"\t--multistep - trim trivial components and the giant component before running alg"<<endl;
+    cerr<<"\t--batch - graphFile is a directory or a manifest listing one graph file per line, which are all solved"
+        " in one process, appending a line to resultsFile for each"<<endl;
+    cerr<<"\t--cache - reuse graphFile.csr as a binary snapshot of graphFile, writing it on first load"<<endl;
+    cerr<<"\t--output format - how components are printed (full, labels or summary, defaults to full)"<<endl;
+    cerr<<"\t--output-file outputFile - file the components are written to instead of the standard output"<<endl;
+    cerr<<"\t--queries queryFile - answer the reachability queries in queryFile, written after the components"<<endl;
+    cerr<<"\t--order order - relabel the vertices before running alg (none, degree, rcm or gorder, defaults to none)"<<endl;
+    cerr<<"\t--compress - run dfs or dcsc on gap encoded neighbour lists, using less memory per edge"<<endl;
+    cerr<<"\t--memory megabytes - memory budget, beyond which the edges are streamed from disk in passes,"
+        " with alg run once the remaining edges fit"<<endl;
+    cerr<<"\t--insert insertFile - insert the edges of insertFile one by one after running alg, maintaining the"
+        " components incrementally, and check them against alg rerun on the grown graph"<<endl;
     exit(EXIT_FAILURE);
 }
 
 
-inline void writeResults(char* fileName, char* graphName, int noVertices, int noEdges, int noComponents, int maxComponentSize, double processingTime)
+inline void writeResults(char* fileName, char* graphName, int noVertices, long long noEdges, int noComponents, int maxComponentSize, double processingTime)
 {
     ofstream resultsFile(fileName, ios_base::app);
 
@@ -237,101 +1876,350 @@ inline void writeResults(char* fileName, char* graphName, int noVertices, int no
     resultsFile.close();
 }
 
+/*
+ * The benchmark in bench/ links this file with its own main.
+ */
+#ifndef BENCHMARK
 int main(int argc, char** argv)
 {
-    if(argc < 3 || argc > 4)
+    PERF_START();
+
+    vector<char*> args;
+    int noThreads = max((int)thread::hardware_concurrency(), 1);
+    bool multistep = false, cache = false, batch = false, compress = false;
+    OUTPUT_TYPE format = OUTPUT_FULL;
+    char* outputFile = nullptr;
+    char* queryFile = nullptr;
+    char* insertFile = nullptr;
+    ORDER_TYPE order = ORDER_NONE;
+    long long memoryBudget = 0;
+    for(int i=1;i<argc;i++)
     {
-        displayError("No. of command-line arguments do not match.");
+        if(!strcmp(argv[i], "--threads"))
+        {
+            if(i + 1 == argc || (noThreads = atoi(argv[++i])) < 1)
+            {
+                displayError("Invalid number of threads.");
+            }
+        }
+        else if(!strcmp(argv[i], "--multistep"))
+        {
+            multistep = true;
+        }
+        else if(!strcmp(argv[i], "--cache"))
+        {
+            cache = true;
+        }
+        else if(!strcmp(argv[i], "--batch"))
+        {
+            batch = true;
+        }
+        else if(!strcmp(argv[i], "--compress"))
+        {
+            compress = true;
+        }
+        else if(!strcmp(argv[i], "--memory"))
+        {
+            if(i + 1 == argc || (memoryBudget = atoll(argv[++i]) << 20) <= 0)
+            {
+                displayError("Invalid memory budget.");
+            }
+        }
+        else if(!strcmp(argv[i], "--output"))
+        {
+            if(i + 1 == argc)
+            {
+                displayError("Missing output format.");
+            }
+            i++;
+            if(!strcmp(argv[i], "full"))
+            {
+                format = OUTPUT_FULL;
+            }
+            else if(!strcmp(argv[i], "labels"))
+            {
+                format = OUTPUT_LABELS;
+            }
+            else if(!strcmp(argv[i], "summary"))
+            {
+                format = OUTPUT_SUMMARY;
+            }
+            else
+            {
+                displayError("Unknown output format.");
+            }
+        }
+        else if(!strcmp(argv[i], "--output-file"))
+        {
+            if(i + 1 == argc)
+            {
+                displayError("Missing output file.");
+            }
+            outputFile = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--queries"))
+        {
+            if(i + 1 == argc)
+            {
+                displayError("Missing query file.");
+            }
+            queryFile = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--insert"))
+        {
+            if(i + 1 == argc)
+            {
+                displayError("Missing insertion file.");
+            }
+            insertFile = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--order"))
+        {
+            if(i + 1 == argc || !parseVertexOrder(argv[++i], order))
+            {
+                displayError("Unknown vertex order.");
+            }
+        }
+        else
+        {
+            args.push_back(argv[i]);
+        }
     }
 
-    ifstream graphFile(argv[1]);
-    if(!graphFile.is_open())
+    if(args.size() < 2 || args.size() > 3)
     {
-        displayError("Cannot open graph file.");
+        displayError("No. of command-line arguments do not match.");
     }
 
     ALG_TYPE alg;
-    if(!strcmp(argv[2], "dfs"))
+    if(!strcmp(args[1], "dfs"))
     {
         alg = ALG_DFS;
     }
-    else if(!strcmp(argv[2], "dcsc"))
+    else if(!strcmp(args[1], "dcsc"))
     {
         alg = ALG_DCSC;
     }
+    else if(!strcmp(args[1], "tarjan"))
+    {
+        alg = ALG_TARJAN;
+    }
+    else if(!strcmp(args[1], "pdcsc"))
+    {
+        alg = ALG_PARALLEL_DCSC;
+    }
+    else if(!strcmp(args[1], "color"))
+    {
+        alg = ALG_COLOR;
+    }
     else
     {
         displayError("Unknown algorithm for getting components.");
     }
 
-    string line;
-    getline(graphFile, line);
-    stringstream ss(line);
-
-    int noVertices, noEdges, sofar = 0;
-    ss>>noVertices>>noEdges;
-
-    unordered_map<int, int> vertexMap, inverseVertexMap;
+    if(compress && (multistep || (alg != ALG_DFS && alg != ALG_DCSC)))
+    {
+        displayError("Compressed adjacencies are only used by dfs and dcsc, without --multistep.");
+    }
 
-    DiGraph graph(noVertices);
-    while(getline(graphFile, line))
+    if(batch)
     {
-        int x, y;
-        stringstream ss(line);
+        if(queryFile || insertFile || outputFile)
+        {
+            displayError("Queries, insertions and output files cannot be used in batch mode.");
+        }
+        if(memoryBudget)
+        {
+            displayError("A memory budget cannot be used in batch mode.");
+        }
+        bool solved = solveBatch(args[0], alg, args.size() == 3 ? args[2] : nullptr, noThreads, multistep, cache, order, compress);
+        return solved ? 0 : EXIT_FAILURE;
+    }
 
-        ss>>x>>y;
-        if(!vertexMap[x])
+    if(memoryBudget)
+    {
+        vector<long long> header;
+        GraphSnapshot snapshot;
+        string snapshotFile = findSnapshot(args[0], cache);
+        if(snapshotFile.empty() ? !readEdgeListHeader(args[0], 2, header) : !snapshot.open(snapshotFile.c_str(), SNAPSHOT_DIGRAPH))
+        {
+            displayError("Cannot open graph file.");
+        }
+        if(!snapshotFile.empty())
         {
-            sofar++;
-            vertexMap[x] = sofar;
-            inverseVertexMap[sofar] = x;
+            header = snapshot.header();
         }
-        if(!vertexMap[y])
+
+        if(estimateInMemoryBytes(header[0], header[1]) > memoryBudget)
         {
-            sofar++;
-            vertexMap[y] = sofar;
-            inverseVertexMap[sofar] = y;
+            if(queryFile || insertFile)
+            {
+                displayError("Reachability queries and insertions need the whole graph in memory, beyond the memory budget.");
+            }
+            solveSemiExternal(args[0], alg, args.size() == 3 ? args[2] : nullptr, noThreads, multistep, cache, order,
+                compress, memoryBudget, format, outputFile);
+            return 0;
         }
-        graph.addEdge(vertexMap[x]-1, vertexMap[y]-1);
     }
-    graphFile.close();
 
-    clock_t start = clock();
-    vector<vector<int> > components = graph.getStronglyConnectedComponents(alg);
-    clock_t stop = clock();
-    double processingTime = (double)(stop - start)/CLOCKS_PER_SEC;
+    GraphInput input;
+    string errorMsg;
+    if(!loadGraphInput(args[0], cache, noThreads, input, errorMsg))
+    {
+        displayError(errorMsg);
+    }
+    int noVertices = input.header[0];
+    long long noEdges = input.header[1];
+
+    DiGraph graph(input.graphSize);
+    graph.setNoThreads(noThreads);
+    graph.setMultistep(multistep);
+    graph.setCompressed(compress);
+    buildDiGraph(args[0], cache, input, graph);
+    const int* originalIds = input.originalIds;
+    int noMappedIds = input.noMappedIds;
+
+    double orderingTime = 0;
+    if(order != ORDER_NONE)
+    {
+        double orderStart = wallTime();
+        graph.reorderVertices(order);
+        orderingTime = wallTime() - orderStart;
+    }
+
+    double start = wallTime();
+    SccResult components = graph.getComponentLabels(alg);
+    double stop = wallTime();
+    double processingTime = stop - start;
 
     cout<<"Graph Info:"<<endl;
     cout<<"\tVertices - "<<noVertices<<", Edges - "<<noEdges<<endl;
-    cout<<"\tNo. of strongly connected components - "<<components.size()<<endl;
-
-    sort(
-        components.begin(),
-        components.end(),
-        [](const vector<int> & a, const vector<int> & b)
-            {
-                return a.size() > b.size();
-            }
-    );
-    cout<<"\tNo. of vertices in largest strongly connected component - "<<components[0].size()<<endl;
+    cout<<"\tNo. of strongly connected components - "<<components.noComponents<<endl;
+    cout<<"\tNo. of vertices in largest strongly connected component - "<<components.maxComponentSize<<endl;
+    if(order != ORDER_NONE)
+    {
+        cout<<"\tOrdering time - "<<FIXED_FLOAT(orderingTime, 6)<<" seconds"<<endl;
+    }
+    if(compress)
+    {
+        long long adjacencySize = graph.getAdjacencySize();
+        cout<<"\tCompressed adjacency - "<<adjacencySize<<" bytes, "
+            <<FIXED_FLOAT((double)adjacencySize / max(noEdges, 1LL), 2)<<" bytes per edge"<<endl;
+    }
 	cout<<"\tProcessing time - "<<FIXED_FLOAT(processingTime, 6)<<" seconds"<<endl<<endl;
 
-    if(argc == 4)
+    if(args.size() == 3)
+    {
+        writeResults(args[2], args[0], noVertices, noEdges, components.noComponents, components.maxComponentSize, processingTime);
+    }
+    PERF_REPORT(args.size() == 3 ? args[2] : nullptr, args[0]);
+
+    /*
+     * The inserted edges grow the graph, so the queries and the written components are
+     * those of the grown graph, found by rerunning alg on it.
+     */
+    if(insertFile)
+    {
+        EdgeList insertions;
+        if(!loadEdgeList(insertFile, 1, 2, insertions, noThreads))
+        {
+            displayError("Cannot open insertion file.");
+        }
+
+        vector<int>& sources = insertions.columns[0];
+        vector<int>& targets = insertions.columns[1];
+        lookupVertexIds(originalIds, noMappedIds, sources, noThreads);
+        lookupVertexIds(originalIds, noMappedIds, targets, noThreads);
+        if(count(sources.begin(), sources.end(), -1) || count(targets.begin(), targets.end(), -1))
+        {
+            displayError("Inserted edges must join vertices of the graph file.");
+        }
+
+        graph.startIncremental(alg);
+        double insertStart = wallTime();
+        for(size_t i=0;i<sources.size();i++)
+        {
+            graph.addEdge(sources[i], targets[i]);
+        }
+        double insertStop = wallTime();
+        SccResult maintained = graph.getComponentLabels(alg);
+        graph.stopIncremental();
+
+        double recomputeStart = wallTime();
+        components = graph.getComponentLabels(alg);
+        double recomputeStop = wallTime();
+        bool matches = samePartition(maintained, components);
+
+        double insertTime = insertStop - insertStart;
+        double recomputeTime = recomputeStop - recomputeStart;
+        cout<<"Insertion Info:"<<endl;
+        cout<<"\tNo. of inserted edges - "<<sources.size()<<endl;
+        cout<<"\tNo. of strongly connected components - "<<maintained.noComponents<<endl;
+        cout<<"\tNo. of vertices in largest strongly connected component - "<<maintained.maxComponentSize<<endl;
+        cout<<"\tInsertion time - "<<FIXED_FLOAT(insertTime, 6)<<" seconds"<<endl;
+        cout<<"\tRecompute time - "<<FIXED_FLOAT(recomputeTime, 6)<<" seconds"<<endl;
+        cout<<"\tMatches recompute - "<<(matches ? "yes" : "no")<<endl<<endl;
+
+        if(!matches)
+        {
+            cerr<<"Error - The incrementally maintained components differ from those found by alg."<<endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    EdgeList queries;
+    vector<char> answers;
+    if(queryFile)
     {
-        writeResults(argv[3], argv[1], noVertices, noEdges, components.size(), components[0].size(), processingTime);
+        if(!loadEdgeList(queryFile, 1, 2, queries, noThreads))
+        {
+            displayError("Cannot open query file.");
+        }
+
+        double buildStart = wallTime();
+        ReachabilityIndex index;
+        index.build(components, graph.getAdjacency(), graph.getVertexOrder(), REACHABILITY_LABELS, noThreads);
+        double buildStop = wallTime();
+
+        vector<int> sources(queries.columns[0]), targets(queries.columns[1]);
+        lookupVertexIds(originalIds, noMappedIds, sources, noThreads);
+        lookupVertexIds(originalIds, noMappedIds, targets, noThreads);
+
+        answers.resize(queries.noEdges());
+        double queryStart = wallTime();
+        index.reachesBatch(sources.data(), targets.data(), answers.size(), answers.data());
+        double queryStop = wallTime();
+
+        double buildTime = buildStop - buildStart;
+        double queryTime = queryStop - queryStart;
+        const CSRAdjacency& condensation = index.getCondensation();
+        cout<<"Reachability Info:"<<endl;
+        cout<<"\tCondensation - "<<components.noComponents<<" components, "<<condensation.offsets[components.noComponents]<<" edges"<<endl;
+        cout<<"\tIndex time - "<<FIXED_FLOAT(buildTime, 6)<<" seconds"<<endl;
+        cout<<"\tNo. of queries - "<<answers.size()<<", reachable - "<<count(answers.begin(), answers.end(), 1)<<endl;
+        cout<<"\tQuery time - "<<FIXED_FLOAT(queryTime, 6)<<" seconds"<<endl<<endl;
     }
 
-    for(int compNo=0;compNo<components.size();compNo++)
+    OutputBuffer out;
+    if(outputFile && !out.open(outputFile))
     {
-        cout<<"Component No. - "<<compNo+1<<endl;
-        cout<<"Component Size - "<<components[compNo].size()<<endl<<"\t";
+        displayError("Cannot open output file.");
+    }
+    writeComponents(out, components, originalIds, format);
 
-        for(auto vertex : components[compNo])
+    if(format != OUTPUT_SUMMARY)
+    {
+        for(size_t i=0;i<answers.size();i++)
         {
-            cout<<inverseVertexMap[vertex+1]<<" ";
+            out.writeInt(queries.columns[0][i]);
+            out.writeChar(' ');
+            out.writeInt(queries.columns[1][i]);
+            out.writeChar(' ');
+            out.writeInt(answers[i]);
+            out.writeChar('\n');
         }
-        cout<<endl;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
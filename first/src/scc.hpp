@@ -3,15 +3,31 @@
 
 #include<vector>
 #include<stack>
-#include<unordered_map>
 #include<string>
+#include<atomic>
+#include<cstdint>
+
+#include "vertex_order.hpp"
+#include "edge_loader.hpp"
+#include "graph_snapshot.hpp"
+#include "compressed_adjacency.hpp"
+#include "scc_output.hpp"
+
+class ThreadPool;
 
 /** \mainpage
 * The aim of the assignment was to implement two algorithms for finding strongly-connected components in
 * a digraph, and compare them. 
 *   
 *   Algorithm 1 - Kosaraju et al.'s DFS based algorithm <br>
-*   Algorithm 2 - Coppersmith et al.'s Divide and Conquer based algorithm
+*   Algorithm 2 - Coppersmith et al.'s Divide and Conquer based algorithm <br>
+*   Algorithm 3 - Pearce's space-efficient variant of Tarjan's one-pass algorithm <br>
+*   Algorithm 4 - Multi-threaded Divide and Conquer (FW-BW) algorithm <br>
+*   Algorithm 5 - Orzan's multi-threaded colour propagation algorithm
+*
+* Components can also be maintained incrementally under edge insertions, using Pearce and
+* Kelly's dynamic topological ordering of the condensation, and reachability queries are
+* answered from GRAIL interval labels of the condensation.
 */
 
 /**
@@ -20,14 +36,147 @@
  * 
  *      ALG_DFS - Kosaraju et al.'s DFS based algorithm
  *      ALG_DCSC - Coppersmith et al.'s Divide and Conquer based algorithm
+ *      ALG_TARJAN - Pearce's space-efficient variant of Tarjan's algorithm
+ *      ALG_PARALLEL_DCSC - Divide and Conquer algorithm run on a work-stealing thread pool
+ *      ALG_COLOR - Orzan's colour propagation algorithm, suited to graphs of high diameter
  *
  */
 enum ALG_TYPE
 {
     ALG_DFS,
-    ALG_DCSC
+    ALG_DCSC,
+    ALG_TARJAN,
+    ALG_PARALLEL_DCSC,
+    ALG_COLOR
+};
+
+/**
+ * \brief Neighbour list of a CSRAdjacency, iterated with a range-based for loop.
+ */
+struct CSRNeighbours
+{
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+};
+
+/**
+ * \brief Compressed sparse row (CSR) representation of the edges of a digraph.
+ *
+ * The neighbours of vertex v are stored contiguously in
+ * targets[offsets[v]] .. targets[offsets[v+1] - 1]. The arrays either point into
+ * the owned storage, or into memory owned by someone else (like a mapped snapshot).
+ */
+struct CSRAdjacency
+{
+    /**
+     * Offsets into targets for every vertex, with one extra sentinel entry at the end.
+     */
+    const int* offsets;
+
+    /**
+     * Flat array holding the neighbours of all the vertices.
+     */
+    const int* targets;
+
+    /**
+     * Storage for offsets and targets, when the arrays are owned by the adjacency.
+     */
+    std::vector<int> offsetStorage;
+    std::vector<int> targetStorage;
+
+    /**
+     * \brief Points offsets and targets at the owned storage.
+     */
+    void useStorage();
+
+    /**
+     * \brief Returns the number of neighbours of a vertex.
+     */
+    int degree(int vertex) const { return offsets[vertex+1] - offsets[vertex]; }
+
+    /**
+     * \brief Returns the neighbours of a vertex.
+     */
+    CSRNeighbours neighbours(int vertex) const { return CSRNeighbours{targets + offsets[vertex], targets + offsets[vertex+1]}; }
+};
+
+/**
+ * \brief Buffers reused by the direction-optimizing searches of the DCSC algorithm.
+ */
+struct SweepBuffers
+{
+    /**
+     * Vertices reached in the last level, and in the level being built.
+     */
+    std::vector<int> frontier, next;
+
+    /**
+     * Bitmap over all the vertices holding the last level during a bottom-up step,
+     * and clear otherwise.
+     */
+    std::vector<uint64_t> frontierBits;
+
+    /**
+     * Bitmap over the positions of the sub-graph, marking the vertices not reached yet.
+     */
+    std::vector<uint64_t> unvisitedBits;
+};
+
+/**
+ * \brief Strongly connected components of a digraph, stored as flat arrays.
+ *
+ * Components are numbered in increasing order of their smallest vertex. The vertices
+ * of component c are vertices[offsets[c]] .. vertices[offsets[c+1] - 1], in increasing order.
+ */
+struct SccResult
+{
+    /**
+     * Component number of every vertex.
+     */
+    std::vector<int> componentOf;
+
+    /**
+     * Offsets into vertices for every component, with one extra sentinel entry at the end.
+     */
+    std::vector<int> offsets;
+
+    /**
+     * Vertices grouped by component.
+     */
+    std::vector<int> vertices;
+
+    /**
+     * Number of components.
+     */
+    int noComponents;
+
+    /**
+     * Number of vertices in the largest component.
+     */
+    int maxComponentSize;
+
+    /**
+     * Number of the largest component, or -1 for an empty digraph.
+     */
+    int largestComponent;
+
+    /**
+     * Number of components made of a single vertex.
+     */
+    int noSingletons;
 };
 
+/**
+ * \brief Builds the flat component arrays from the representative of every vertex.
+ *
+ * @param noVertices - number of vertices
+ * @param representative - a vertex of its component, for every vertex
+ * @param result - filled with the components
+ */
+void collectComponents(int noVertices, const std::vector<int>& representative, SccResult& result);
+
 /**
  * Class template for the DiGraph abstract data-type.
  */
@@ -40,57 +189,355 @@ class DiGraph
         int noVertices;
 
         /**
-         * Adjacency list used to store the digraph's edges.
+         * Number of threads used by the parallel algorithms.
+         */
+        int noThreads;
+
+        /**
+         * Whether the Multistep preprocessing is run before the chosen algorithm.
+         */
+        bool multistep;
+
+        /**
+         * Sources of the edges added since the adjacency was last built.
+         */
+        std::vector<int> edgeSources;
+
+        /**
+         * Destinations of the edges added since the adjacency was last built.
+         */
+        std::vector<int> edgeTargets;
+
+        /**
+         * CSR adjacency used to store the digraph's edges.
+         */
+        CSRAdjacency adj;
+
+        /**
+         * CSR adjacency used to store the edges in the transpose digraph.
+         */
+        CSRAdjacency transposeAdj;
+
+        /**
+         * Whether adj holds all the edges added so far.
+         */
+        bool adjBuilt;
+
+        /**
+         * Whether transposeAdj is up to date with adj.
          */
-        std::vector<std::vector<int> > adj;
+        bool transposeBuilt;
 
         /**
-         * Adjacency list used to store the edges in the transpose digraph.
+         * Whether the DFS and DCSC algorithms run on compressed adjacencies.
          */
-        std::vector<std::vector<int> > transposeAdj;
+        bool compressed;
 
         /**
-         * Compute and return the adjacency list for the transpose digraph.
+         * Compressed adjacencies of the digraph and of its transpose.
          */
-        std::vector<std::vector<int> > getTranspose();
+        CompressedAdjacency compressedAdj, compressedTranspose;
+
+        /**
+         * Whether compressedAdj and compressedTranspose hold the edges, in place of adj
+         * and transposeAdj, whose storage is then freed.
+         */
+        bool compressedBuilt;
+
+        /**
+         * New id of every vertex after reorderVertices, or empty if the vertices keep
+         * their ids. The adjacency and every engine work on the new ids.
+         */
+        std::vector<int> vertexOrder;
+
+        /**
+         * Original id of every new id, or empty if the vertices keep their ids.
+         */
+        std::vector<int> vertexOrigin;
+
+        /**
+         * Whether the components are maintained incrementally as edges are added.
+         */
+        bool incremental;
+
+        /**
+         * Algorithm used to recompute the components in incremental mode.
+         */
+        ALG_TYPE incrementalAlg;
+
+        /**
+         * Number of components maintained in incremental mode.
+         */
+        int noComponents;
+
+        /**
+         * Union-find parent of every vertex, the root of every tree being the representative
+         * of a strong component.
+         */
+        std::vector<int> componentParent;
+
+        /**
+         * Number of vertices of every component, valid at its representative.
+         */
+        std::vector<int> componentSize;
+
+        /**
+         * Position of every component in a topological order of the condensation, valid at
+         * its representative. Positions are distinct, but not necessarily contiguous.
+         */
+        std::vector<int> topoOrder;
+
+        /**
+         * Destinations of the edges leaving every component, and sources of the edges
+         * entering it, valid at its representative. Entries may have been merged into the
+         * component itself since they were added.
+         */
+        std::vector<std::vector<int> > componentOut, componentIn;
+
+        /**
+         * Visit marks of the forward and backward searches of an insertion, compared against
+         * the stamp of the current insertion.
+         */
+        std::vector<int> forwardMark, backwardMark;
+        int searchStamp;
+
+        /**
+         * \brief Merges the pending edges into the CSR adjacency using a counting-sort pass.
+         */
+        void buildAdjacency();
+
+        /**
+         * \brief Computes the CSR adjacency for the transpose digraph from adj,
+         * if it is not already up to date.
+         */
+        void buildTranspose();
+
+        /**
+         * \brief Encodes adj and its transpose into the compressed adjacencies, if they
+         * are not already built, and frees the CSR storage.
+         */
+        void compressAdjacency();
+
+        /**
+         * \brief Decodes the compressed adjacency back into adj, if the edges are only
+         * held in compressed form.
+         */
+        void expandAdjacency();
 
         /**
          * \brief Determine the order of DFS calls on vertices in the transpose graph
          * for the second run of Kosaraju's algorithm.
+         *
+         * The search runs from every vertex not done, with an explicit stack of the vertices on
+         * the search path, so that the long paths of large components do not overflow the stack.
          * 
-         * @param curr - vertex on which DFS call is performed
+         * @param forward - the adjacency of the digraph (adj, or compressedAdj)
+         * @param label - partition label of every vertex
          * @param visited - list of booleans to keep track of vertices to make sure they are processed only once
          * @param visitOrder - stack of vertices representing the visitation order in the second run
          */
-        void fillStack(int curr, std::vector<bool>& visited, std::stack<int>& visitOrder);
+        template<class Adjacency>
+        void fillStack(const Adjacency& forward, const std::vector<int>& label, std::vector<bool>& visited, std::stack<int>& visitOrder);
 
         /**
-         * \brief Private method to run Kosaraju et al.'s DFS algorithm, and return
+         * \brief Private method to run Kosaraju et al.'s DFS algorithm, and find
          * strongly-connected components.
+         *
+         * @param forward - the adjacency of the digraph (adj, or compressedAdj)
+         * @param reverse - the adjacency of the transpose digraph (transposeAdj, or compressedTranspose)
+         * @param label - partition label of every vertex
+         * @param representative - set to a vertex of its component for every vertex whose component is found
+         */
+        template<class Adjacency>
+        void dfs(const Adjacency& forward, const Adjacency& reverse, const std::vector<int>& label, std::vector<int>& representative);
+
+        /**
+         * \brief Private method to run Pearce's iterative variant of Tarjan's algorithm,
+         * and return strongly-connected components.
+         *
+         * The components are found in a single forward pass using an explicit call stack,
+         * so neither the transpose digraph nor recursion is needed.
+         *
+         * @param label - partition label of every vertex
+         * @param representative - set to a vertex of its component for every vertex whose component is found
          */
-        std::vector<std::vector<int> > dfs();
+        void tarjan(const std::vector<int>& label, std::vector<int>& representative);
 
         /**
-         * \brief Performs a DFS call on the current vertex, and marks its neighbours in a boolean array.
+         * \brief Sorts the vertices which are not done by their partition label, and returns
+         * the number of labels in use.
+         *
+         * @param label - partition label of every vertex
+         * @param vertices - filled with the vertices, grouped by label
+         * @param groups - filled with the range of vertices for every non-empty label
+         */
+        int groupVertices(const std::vector<int>& label, std::vector<int>& vertices, std::vector<std::pair<int, int> >& groups);
+
+        /**
+         * \brief Performs a DFS call on the current vertex, relabelling the vertices it reaches.
          * Used to calculate predecessor and descendent sets in the DCSC algorithm.
          *
-         * @param curr - vertex on which to perform the DFS call
-         * @param visited - list of booleans in which the visited vertices are marked as true
-         * @param done - list of booleans representing vertices whose strong components have already been found
-         * @param adjSet - the adjacency list to be used for edges (transposeAdj for predecessors, adj for descendents)
+         * Only vertices labelled fromLabel or sharedLabel are traversed. The former are
+         * relabelled toLabel, and the latter (already reached by the other search) sccLabel.
+         *
+         * @param curr - vertex on which to perform the DFS call, already relabelled by the caller
+         * @param adjSet - the adjacency to be used for edges (transposeAdj for predecessors, adj for descendents)
+         * @param label - partition label of every vertex
+         * @param fromLabel - label of the unreached vertices in the current sub-graph
+         * @param toLabel - label given to the unreached vertices
+         * @param sharedLabel - label of the vertices reached by the other search, or LABEL_NONE
+         * @param sccLabel - label given to the vertices reached by both searches
+         * @param dfsHelper - stack reused between calls to avoid allocations
+         */
+        template<class Adjacency>
+        void dcscVisitor(int curr, const Adjacency& adjSet, std::vector<int>& label, int fromLabel, int toLabel,
+            int sharedLabel, int sccLabel, std::vector<int>& dfsHelper);
+
+        /**
+         * \brief Direction-optimizing counterpart of dcscVisitor, used for large sub-graphs.
+         *
+         * The search is level-synchronous, and switches between top-down and bottom-up
+         * steps in the manner of Beamer et al. A top-down step follows the edges of the
+         * last level, as dcscVisitor does. Once the last level has more edges than the
+         * unreached vertices of the sub-graph (scaled by a constant), a bottom-up step
+         * instead checks every unreached vertex for an edge from the last level. The last
+         * level is then held in a bitmap, and the unreached vertices in a bitmap over the
+         * sub-graph which is scanned a word at a time.
+         *
+         * @param curr - vertex from which to start the search, already relabelled by the caller
+         * @param adjSet - the adjacency to be used for edges (transposeAdj for predecessors, adj for descendents)
+         * @param reverseSet - the reverse of adjSet
+         * @param label - partition label of every vertex
+         * @param fromLabel - label of the unreached vertices in the current sub-graph
+         * @param toLabel - label given to the unreached vertices
+         * @param sharedLabel - label of the vertices reached by the other search, or LABEL_NONE
+         * @param sccLabel - label given to the vertices reached by both searches
+         * @param subGraph - vertices of the current sub-graph
+         * @param subGraphSize - number of vertices of the current sub-graph
+         * @param buffers - buffers reused between calls
          */
-        void dcscVisitor(int curr, std::vector<bool>& visited, std::vector<bool>& done, std::vector<std::vector<int> >& adjSet);
+        template<class Adjacency>
+        void sweepVisitor(int curr, const Adjacency& adjSet, const Adjacency& reverseSet, std::vector<int>& label,
+            int fromLabel, int toLabel, int sharedLabel, int sccLabel, const int* subGraph, int subGraphSize,
+            SweepBuffers& buffers);
 
         /**
          * \brief Private method to run the Divide and Conquer algorithm and return 
          * strongly connected components.
+         *
+         * Every sub-graph is a contiguous range of a vertex permutation whose vertices share
+         * a partition label, so the work done for a sub-graph is proportional to its size.
+         * Sub-graphs are processed from an explicit worklist instead of recursion.
          * 
-         * @param vertexSet - list of vertices in the sub-graph we are finding the component for
-         * @param done - list of booleans representing vertices whose strong components have already been found
-         * @param adjSet - the adjacency list to be used for edges (transposeAdj for predecessors, adj for descendents)
+         * @param forward - the adjacency of the digraph (adj, or compressedAdj)
+         * @param reverse - the adjacency of the transpose digraph (transposeAdj, or compressedTranspose)
+         * @param label - partition label of every vertex, used as the working labels
+         * @param representative - set to a vertex of its component for every vertex whose component is found
+         */
+        template<class Adjacency>
+        void dcsc(const Adjacency& forward, const Adjacency& reverse, std::vector<int>& label, std::vector<int>& representative);
+
+        /**
+         * \brief Level-synchronous counterpart of dcscVisitor used by the parallel DCSC algorithm.
+         *
+         * Frontiers larger than a threshold are expanded in parallel on the thread pool, and
+         * vertices are relabelled with atomic compare-and-swap so every vertex is claimed once.
+         *
+         * @param curr - vertex from which to start the search, already relabelled by the caller
+         * @param adjSet - the adjacency to be used for edges (transposeAdj for predecessors, adj for descendents)
+         * @param label - partition label of every vertex
+         * @param fromLabel - label of the unreached vertices in the current sub-graph
+         * @param toLabel - label given to the unreached vertices
+         * @param sharedLabel - label of the vertices reached by the other search, or LABEL_NONE
+         * @param sccLabel - label given to the vertices reached by both searches
+         * @param pool - thread pool used to expand large frontiers
+         */
+        void parallelDcscVisitor(int curr, const CSRAdjacency& adjSet, std::vector<std::atomic<int> >& label,
+            int fromLabel, int toLabel, int sharedLabel, int sccLabel, ThreadPool& pool);
+
+        /**
+         * \brief Private method to run the Divide and Conquer algorithm on a work-stealing
+         * thread pool and return strongly connected components.
+         *
+         * The three sub-graphs produced for every pivot are independent, and large ones are
+         * spawned as tasks. Components are ordered by their smallest vertex, so the result
+         * does not depend on the scheduling of the tasks.
+         *
+         * @param label - partition label of every vertex
+         * @param representative - set to a vertex of its component for every vertex whose component is found
+         */
+        void parallelDcsc(const std::vector<int>& label, std::vector<int>& representative);
+
+        /**
+         * \brief Private method to run Orzan's colour propagation algorithm and find
+         * strongly connected components.
+         *
+         * Every remaining vertex starts with its own number as colour, and the largest colour
+         * is propagated along edges with synchronous parallel sweeps until no colour changes.
+         * The component of every vertex whose colour is its own number is then the set of
+         * vertices of that colour which reach it, found by a backward search. Both steps are
+         * repeated on the vertices left over.
+         *
+         * @param label - partition label of every vertex, used as the working labels
+         * @param representative - set to a vertex of its component for every vertex whose component is found
+         */
+        void colorPropagation(std::vector<int>& label, std::vector<int>& representative);
+
+        /**
+         * \brief Runs the chosen algorithm, or reads the incrementally maintained components,
+         * and finds a representative for every vertex, both in the internal vertex ids.
+         *
+         * @param alg - algorithm to be used for finding the components
+         * @param representative - filled with a vertex of its component for every vertex
+         */
+        void findRepresentatives(ALG_TYPE alg, std::vector<int>& representative);
+
+        /**
+         * \brief Multistep preprocessing of Slota et al., run before the chosen algorithm.
+         *
+         * Vertices with no incoming or outgoing edges are trimmed repeatedly in parallel,
+         * the giant component is found with one FW-BW search from the vertex of largest
+         * degree, and the remaining vertices are labelled by weakly connected component.
+         *
+         * @param label - filled with the partition label of every vertex
+         * @param representative - set to a vertex of its component for every vertex whose component is found
+         */
+        void multistepPreprocess(std::vector<int>& label, std::vector<int>& representative);
+
+        /**
+         * \brief Returns the representative of the component of a vertex in incremental mode.
+         *
+         * @param vertex - vertex whose component is looked up
          */
-        void dcsc(std::vector<int>& vertexSet, std::vector<bool>& done, std::vector<std::vector<int> >& adjSet);
-        
+        int findComponent(int vertex);
+
+        /**
+         * \brief Searches the condensation from a component, visiting only the components
+         * whose topological position is within a bound, and returns them.
+         *
+         * @param start - representative of the component to start from
+         * @param forward - whether edges are followed forwards (positions up to bound) or
+         * backwards (positions from bound)
+         * @param bound - bound on the position of the visited components
+         * @param visited - filled with the representatives of the visited components
+         */
+        void boundedSearch(int start, bool forward, int bound, std::vector<int>& visited);
+
+        /**
+         * \brief Inserts an edge in incremental mode, following the dynamic topological
+         * ordering algorithm of Pearce and Kelly on the condensation.
+         *
+         * If the edge goes against the topological order, the components reachable from
+         * its destination and the components reaching its source are searched, within
+         * the positions the edge spans. The components found by both searches form a
+         * cycle with the edge and are merged, and the searched components are reordered
+         * among their own positions.
+         *
+         * @param x - source of the edge
+         * @param y - destination of the edge
+         */
+        void insertEdge(int x, int y);
+
     public:
         /**
          * \brief Constructor used for creating the digraph object.
@@ -100,12 +547,87 @@ class DiGraph
         DiGraph(int noVertices);
 
         /**
-         * \brief Adds an edge between two vertices, x -> y
+         * \brief Adds an edge between two vertices, x -> y. In incremental mode the
+         * components are updated as well.
          *
          * @param x - source of the edge
          * @param y - destination of the edge
          */
-        inline void addEdge(int x, int y);
+        void addEdge(int x, int y);
+
+        /**
+         * \brief Adds a list of edges, sources[i] -> targets[i]. The lists are taken over
+         * by the digraph and left empty.
+         *
+         * In incremental mode a large batch, compared to the edges already in the digraph,
+         * makes the components to be recomputed once, and a small one is inserted edge by edge.
+         *
+         * @param sources - sources of the edges
+         * @param targets - destinations of the edges
+         */
+        void addEdges(std::vector<int>& sources, std::vector<int>& targets);
+
+        /**
+         * \brief Sets the number of threads used by the parallel algorithms.
+         *
+         * @param noThreads - number of threads, including the calling thread
+         */
+        void setNoThreads(int noThreads);
+
+        /**
+         * \brief Uses an existing CSR adjacency as the digraph's edges, without copying it.
+         * The arrays must outlive the digraph, and replace any edges added before.
+         *
+         * @param offsets - offsets into targets for every vertex, with a sentinel entry at the end
+         * @param targets - neighbours of all the vertices
+         */
+        void setAdjacency(const int* offsets, const int* targets);
+
+        /**
+         * \brief Returns the CSR adjacency of the digraph, building it if needed. After
+         * reorderVertices, it is given in the new vertex ids.
+         */
+        const CSRAdjacency& getAdjacency();
+
+        /**
+         * \brief Relabels the vertices of the digraph to improve the locality of the
+         * searches. The engines then run on the new ids, while every vertex passed to or
+         * returned by the public interface keeps its original id. Incremental mode is
+         * stopped.
+         *
+         * @param order - order in which the vertices are relabelled
+         */
+        void reorderVertices(ORDER_TYPE order);
+
+        /**
+         * \brief Returns the new id of every vertex after reorderVertices, or an empty list
+         * if the vertices keep their ids.
+         */
+        const std::vector<int>& getVertexOrder();
+
+        /**
+         * \brief Sets whether the Multistep preprocessing (trimming, giant component
+         * and weakly connected components) is run before the chosen algorithm.
+         *
+         * @param multistep - whether to run the preprocessing
+         */
+        void setMultistep(bool multistep);
+
+        /**
+         * \brief Sets whether the DFS and DCSC algorithms run on compressed adjacencies,
+         * which hold sorted, gap encoded neighbour lists instead of the CSR arrays. The
+         * other algorithms, and the Multistep preprocessing, decode the CSR adjacency
+         * back when they run.
+         *
+         * @param compressed - whether to compress the adjacencies
+         */
+        void setCompressed(bool compressed);
+
+        /**
+         * \brief Returns the number of bytes used by the adjacencies of the digraph and
+         * of its transpose, in the form they are held in.
+         */
+        long long getAdjacencySize();
 
         /**
          * Public interface exposed to the caller, for finding strongly-connected
@@ -114,8 +636,145 @@ class DiGraph
          * @param ALG_TYPE - algorithm to be used for finding the components
          */
         std::vector<std::vector<int> > getStronglyConnectedComponents(ALG_TYPE);
+
+        /**
+         * \brief Finds the strongly-connected components, and returns them as a component
+         * number for every vertex along with the vertices grouped by component.
+         *
+         * @param ALG_TYPE - algorithm to be used for finding the components
+         */
+        SccResult getComponentLabels(ALG_TYPE);
+
+        /**
+         * \brief Finds the strongly-connected components, and keeps them up to date as
+         * edges are added from then on, until incremental mode is stopped. While it is on,
+         * getComponentLabels and getStronglyConnectedComponents return the maintained
+         * components without running an algorithm.
+         *
+         * @param alg - algorithm used for finding the components, and for recomputing them
+         * after large batches of edges
+         */
+        void startIncremental(ALG_TYPE alg);
+
+        /**
+         * \brief Stops maintaining the components and frees the incremental state.
+         */
+        void stopIncremental();
+
+        /**
+         * \brief Returns the representative vertex of the component of a vertex in
+         * incremental mode. Two vertices are strongly connected iff their representatives match.
+         *
+         * @param vertex - vertex whose component is looked up
+         */
+        int getComponent(int vertex);
+
+        /**
+         * \brief Returns the number of strong components in incremental mode.
+         */
+        int getNoComponents();
 };
 
+/**
+ * \brief A graph file loaded for building a DiGraph, either parsed from text with its
+ * vertex ids mapped to dense ids, or memory-mapped from a binary snapshot.
+ */
+struct GraphInput
+{
+    /**
+     * Snapshot the graph was mapped from, if fromSnapshot is set.
+     */
+    GraphSnapshot snapshot;
+
+    /**
+     * Edges parsed from the text file, with dense ids, if fromSnapshot is not set.
+     */
+    EdgeList edges;
+
+    /**
+     * Whether the graph was mapped from a snapshot.
+     */
+    bool fromSnapshot;
+
+    /**
+     * Numbers on the header line of the graph file.
+     */
+    std::vector<long long> header;
+
+    /**
+     * Raw id of every dense id, stored in originalIdStorage for text files and in the
+     * snapshot otherwise, and the number of them which are in increasing order.
+     */
+    std::vector<int> originalIdStorage;
+    const int* originalIds;
+    int noMappedIds;
+
+    /**
+     * Number of vertices of the DiGraph to be built.
+     */
+    int graphSize;
+};
+
+/**
+ * \brief Loads a graph file, as text or as a binary snapshot, and returns whether it
+ * succeeded, setting errorMsg otherwise.
+ *
+ * @param fileName - path of the graph file
+ * @param cache - whether a cached snapshot of a text file is used
+ * @param noThreads - number of threads used for parsing and mapping ids
+ * @param input - filled with the loaded graph
+ * @param errorMsg - set to the cause of a failure
+ */
+bool loadGraphInput(const char* fileName, bool cache, int noThreads, GraphInput& input, std::string& errorMsg);
+
+/**
+ * \brief Moves the edges of a loaded graph into a DiGraph of input.graphSize vertices,
+ * writing the snapshot of a text file if cache is set.
+ *
+ * @param fileName - path of the graph file
+ * @param cache - whether the snapshot of a text file is written
+ * @param input - loaded graph, whose edges are consumed
+ * @param graph - digraph the edges are added to
+ */
+void buildDiGraph(const char* fileName, bool cache, GraphInput& input, DiGraph& graph);
+
+/**
+ * \brief Finds the strong components of every graph of a directory or a manifest, as
+ * described for runBatch, appending a results line for every graph to resultsFile.
+ *
+ * Returns whether every graph was solved.
+ *
+ * @param batchPath - directory or manifest of graph files
+ * @param alg - algorithm used for finding the components
+ * @param resultsFile - file the results lines are appended to, or nullptr
+ * @param noThreads - number of threads
+ * @param multistep - whether the multistep preprocessing is run
+ * @param cache - whether binary snapshots of the graphs are used and written
+ * @param order - order in which the vertices are relabelled before running alg
+ * @param compress - whether dfs and dcsc run on compressed adjacencies
+ */
+bool solveBatch(char* batchPath, ALG_TYPE alg, char* resultsFile, int noThreads, bool multistep, bool cache, ORDER_TYPE order,
+    bool compress);
+
+/**
+ * \brief Finds the strong components of a graph file with SemiExternalScc, within a memory
+ * budget, and writes them out as for a graph solved in memory.
+ *
+ * @param fileName - path of the graph file
+ * @param alg - algorithm used once the remaining edges fit in memory
+ * @param resultsFile - file the results line is appended to, or nullptr
+ * @param noThreads - number of threads used by alg
+ * @param multistep - whether the multistep preprocessing is run by alg
+ * @param cache - whether a cached snapshot of the graph is read
+ * @param order - order in which the remaining vertices are relabelled before running alg
+ * @param compress - whether alg runs on compressed adjacencies
+ * @param memoryBudget - memory budget in bytes
+ * @param format - how the components are written
+ * @param outputFile - file the components are written to, or nullptr for the standard output
+ */
+void solveSemiExternal(char* fileName, ALG_TYPE alg, char* resultsFile, int noThreads, bool multistep, bool cache,
+    ORDER_TYPE order, bool compress, long long memoryBudget, OUTPUT_TYPE format, char* outputFile);
+
 /**
  * \brief Function for displaying any errors caused during execution.
  *
@@ -138,6 +797,6 @@ inline void displayError(std::string errorMsg);
  * @param maxComponentSize - number of vertices in the largest strong component
  * @param processingTime - time required to find strong components
  */
-inline void writeResults(char* fileName, char* graphName, int noVertices, int noEdges, int noComponents, int maxComponentSize, double processingTime);
+inline void writeResults(char* fileName, char* graphName, int noVertices, long long noEdges, int noComponents, int maxComponentSize, double processingTime);
 
 #endif
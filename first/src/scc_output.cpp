@@ -0,0 +1,180 @@
+#include<vector>
+#include<cstring>
+
+#include<fcntl.h>
+#include<unistd.h>
+
+#include "scc.hpp"
+#include "scc_output.hpp"
+
+using namespace std;
+
+
+/**
+ * Size of the buffer of an OutputBuffer, in bytes.
+ */
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+
+OutputBuffer::OutputBuffer() : fd(STDOUT_FILENO), ownsFd(false), buffer(OUTPUT_BUFFER_SIZE), used(0)
+{
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    flush();
+    if(ownsFd)
+    {
+        close(fd);
+    }
+}
+
+bool OutputBuffer::open(const char* fileName)
+{
+    int file = ::open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(file == -1)
+    {
+        return false;
+    }
+
+    flush();
+    if(ownsFd)
+    {
+        close(fd);
+    }
+    fd = file;
+    ownsFd = true;
+    return true;
+}
+
+void OutputBuffer::reserve(size_t n)
+{
+    if(used + n > buffer.size())
+    {
+        flush();
+    }
+}
+
+void OutputBuffer::writeString(const char* text)
+{
+    size_t length = strlen(text);
+    if(length > buffer.size())
+    {
+        flush();
+        for(size_t done=0;done<length;)
+        {
+            ssize_t written = write(fd, text + done, length - done);
+            if(written <= 0)
+            {
+                return;
+            }
+            done += written;
+        }
+        return;
+    }
+
+    reserve(length);
+    memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void OutputBuffer::writeChar(char c)
+{
+    reserve(1);
+    buffer[used++] = c;
+}
+
+void OutputBuffer::writeInt(long long value)
+{
+    reserve(20);
+
+    unsigned long long magnitude = value < 0 ? -(unsigned long long)value : value;
+    if(value < 0)
+    {
+        buffer[used++] = '-';
+    }
+
+    char digits[20];
+    int noDigits = 0;
+    do
+    {
+        digits[noDigits++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    }
+    while(magnitude);
+
+    while(noDigits)
+    {
+        buffer[used++] = digits[--noDigits];
+    }
+}
+
+void OutputBuffer::flush()
+{
+    for(size_t done=0;done<used;)
+    {
+        ssize_t written = write(fd, buffer.data() + done, used - done);
+        if(written <= 0)
+        {
+            break;
+        }
+        done += written;
+    }
+    used = 0;
+}
+
+void writeComponents(OutputBuffer& out, const SccResult& result, const int* originalIds, OUTPUT_TYPE format)
+{
+    if(format == OUTPUT_LABELS)
+    {
+        for(int vertex=0;vertex<(int)result.componentOf.size();vertex++)
+        {
+            out.writeInt(originalIds[vertex]);
+            out.writeChar(' ');
+            out.writeInt(result.componentOf[vertex] + 1);
+            out.writeChar('\n');
+        }
+        return;
+    }
+
+    if(format != OUTPUT_FULL)
+    {
+        return;
+    }
+
+    /*
+     * Counting sort of the components by decreasing size, which keeps components of
+     * equal size in the order of their smallest vertex.
+     */
+    vector<int> bucket(result.maxComponentSize + 2, 0);
+    for(int id=0;id<result.noComponents;id++)
+    {
+        bucket[result.maxComponentSize - (result.offsets[id+1] - result.offsets[id]) + 1]++;
+    }
+    for(int size=1;size<(int)bucket.size();size++)
+    {
+        bucket[size] += bucket[size-1];
+    }
+    vector<int> order(result.noComponents);
+    for(int id=0;id<result.noComponents;id++)
+    {
+        order[bucket[result.maxComponentSize - (result.offsets[id+1] - result.offsets[id])]++] = id;
+    }
+
+    for(int compNo=0;compNo<result.noComponents;compNo++)
+    {
+        int id = order[compNo];
+        out.writeString("Component No. - ");
+        out.writeInt(compNo + 1);
+        out.writeString("\nComponent Size - ");
+        out.writeInt(result.offsets[id+1] - result.offsets[id]);
+        out.writeString("\n\t");
+
+        for(int i=result.offsets[id];i<result.offsets[id+1];i++)
+        {
+            out.writeInt(originalIds[result.vertices[i]]);
+            out.writeChar(' ');
+        }
+        out.writeChar('\n');
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef scc_output_hpp
+#define scc_output_hpp
+
+#include<vector>
+
+struct SccResult;
+
+/**
+ * \brief Enum representing the format in which components are written.
+ *
+ *      OUTPUT_FULL - every component with its number, size and vertices, largest first
+ *      OUTPUT_LABELS - one line per vertex, holding the vertex and the number of its component
+ *      OUTPUT_SUMMARY - no components, only the graph info
+ *
+ */
+enum OUTPUT_TYPE
+{
+    OUTPUT_FULL,
+    OUTPUT_LABELS,
+    OUTPUT_SUMMARY
+};
+
+/**
+ * Class template for a buffered writer to a file descriptor.
+ *
+ * Output is gathered in a large buffer and handed to write(2) when the buffer fills up,
+ * and integers are formatted directly into the buffer, avoiding the per-call overhead
+ * of iostreams when millions of numbers are written.
+ */
+class OutputBuffer
+{
+    private:
+        /**
+         * File descriptor written to.
+         */
+        int fd;
+
+        /**
+         * Whether the file descriptor was opened by the writer and is closed by it.
+         */
+        bool ownsFd;
+
+        /**
+         * Buffered bytes, and the number of them in use.
+         */
+        std::vector<char> buffer;
+        size_t used;
+
+        /**
+         * \brief Makes room for at least n more bytes in the buffer.
+         */
+        void reserve(size_t n);
+
+    public:
+        /**
+         * \brief Creates a writer to the standard output.
+         */
+        OutputBuffer();
+
+        /**
+         * \brief Flushes the buffer, and closes the file if it was opened by the writer.
+         */
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        /**
+         * \brief Redirects the writer to a file, truncating it, and returns whether it could be opened.
+         *
+         * @param fileName - path of the file
+         */
+        bool open(const char* fileName);
+
+        /**
+         * \brief Appends a null-terminated string.
+         */
+        void writeString(const char* text);
+
+        /**
+         * \brief Appends a single character.
+         */
+        void writeChar(char c);
+
+        /**
+         * \brief Appends an integer in decimal.
+         */
+        void writeInt(long long value);
+
+        /**
+         * \brief Writes out the buffered bytes.
+         */
+        void flush();
+};
+
+/**
+ * \brief Writes the components in the given format.
+ *
+ * Components are numbered from 1 in the written output. In the full format they are listed
+ * by decreasing size, ties being broken by their smallest vertex. In the labels format the
+ * component numbers follow the order of the smallest vertex of each component.
+ *
+ * @param out - writer the components are written to
+ * @param result - components of the digraph
+ * @param originalIds - id of every vertex as given in the graph file
+ * @param format - format of the output
+ */
+void writeComponents(OutputBuffer& out, const SccResult& result, const int* originalIds, OUTPUT_TYPE format);
+
+#endif
@@ -0,0 +1,466 @@
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<cstdint>
+
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+
+#include "semi_external.hpp"
+#include "edge_loader.hpp"
+#include "graph_snapshot.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+/**
+ * Bytes taken per edge and per vertex when a graph is solved in memory: the parsed edge
+ * columns and the CSR being built from them at the peak, and the labels and the
+ * component arrays of every vertex.
+ */
+const long long IN_MEMORY_EDGE_BYTES = 16;
+const long long IN_MEMORY_VERTEX_BYTES = 48;
+
+/**
+ * Bytes of per-vertex state kept by the semi-external passes, including the original ids.
+ */
+const long long SEMI_EXTERNAL_VERTEX_BYTES = 24;
+
+/**
+ * Number of edges parsed at a time while converting a text graph file.
+ */
+const int STREAM_BLOCK = 1 << 20;
+
+/**
+ * Trimming is repeated while a pass trims at least one vertex in this many.
+ */
+const int SEMI_EXTERNAL_TRIM_RATIO = 64;
+
+
+long long estimateInMemoryBytes(long long noVertices, long long noEdges)
+{
+    return noEdges * IN_MEMORY_EDGE_BYTES + noVertices * IN_MEMORY_VERTEX_BYTES;
+}
+
+SemiExternalScc::SemiExternalScc(long long memoryBudget, int noThreads)
+{
+    this->memoryBudget = memoryBudget;
+    this->noThreads = noThreads;
+    noVertices = 0;
+    noLive = 0;
+    offsets = nullptr;
+    targets = nullptr;
+    pairs = nullptr;
+    noPairs = 0;
+    noPasses = 0;
+}
+
+SemiExternalScc::~SemiExternalScc()
+{
+    if(pairs)
+    {
+        munmap(pairs, max(noPairs, 1LL) * 2 * sizeof(int));
+    }
+}
+
+template<class Visit>
+void SemiExternalScc::streamEdges(Visit visit)
+{
+    noPasses++;
+    if(offsets)
+    {
+        for(int x=0;x<noVertices;x++)
+        {
+            for(int i=offsets[x];i<offsets[x+1];i++)
+            {
+                visit(x, targets[i]);
+            }
+        }
+        return;
+    }
+
+    for(long long i=0;i<noPairs;i++)
+    {
+        visit(pairs[2*i], pairs[2*i+1]);
+    }
+}
+
+bool SemiExternalScc::convertText(const char* fileName, vector<long long>& header, vector<int>& originalIds, string& errorMsg)
+{
+    PERF_REGION("semi-external:convert");
+
+    /*
+     * The first pass finds the range of the raw ids, and the second one marks the ids in
+     * use in a bitmap over that range while writing the edges out.
+     */
+    long long minId = 0, maxId = -1;
+    auto findRange = [&](vector<vector<int> >& columns)
+    {
+        for(int c=0;c<2;c++)
+        {
+            auto range = minmax_element(columns[c].begin(), columns[c].end());
+            minId = maxId < minId ? *range.first : min(minId, (long long)*range.first);
+            maxId = max(maxId, (long long)*range.second);
+        }
+    };
+    noPasses++;
+    if(!streamEdgeList(fileName, 2, 2, STREAM_BLOCK, header, findRange))
+    {
+        errorMsg = "Cannot open graph file.";
+        return false;
+    }
+
+    long long noWords = maxId < minId ? 1 : ((maxId - minId) >> 6) + 1;
+    if(noWords * (long long)(sizeof(uint64_t) + sizeof(uint32_t)) > memoryBudget)
+    {
+        errorMsg = "The vertex ids span too wide a range for the memory budget.";
+        return false;
+    }
+
+    string path = string(fileName) + ".edges.XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if(fd == -1)
+    {
+        errorMsg = "Cannot create the edge file next to the graph file.";
+        return false;
+    }
+    unlink(path.c_str());
+
+    vector<uint64_t> present(noWords, 0);
+    vector<int> buffer;
+    bool written = true;
+    auto writeEdges = [&](vector<vector<int> >& columns)
+    {
+        buffer.resize(2 * columns[0].size());
+        for(size_t i=0;i<columns[0].size();i++)
+        {
+            for(int c=0;c<2;c++)
+            {
+                long long offset = columns[c][i] - minId;
+                present[offset >> 6] |= 1ULL << (offset & 63);
+                buffer[2*i+c] = columns[c][i];
+            }
+        }
+        noPairs += columns[0].size();
+
+        const char* data = (const char*)buffer.data();
+        size_t left = buffer.size() * sizeof(int);
+        while(written && left)
+        {
+            ssize_t count = write(fd, data, left);
+            written = count > 0;
+            data += max(count, (ssize_t)0);
+            left -= max(count, (ssize_t)0);
+        }
+    };
+    noPasses++;
+    streamEdgeList(fileName, 2, 2, STREAM_BLOCK, header, writeEdges);
+    vector<int>().swap(buffer);
+
+    long long mappingSize = max(noPairs, 1LL) * 2 * sizeof(int);
+    void* mapping = MAP_FAILED;
+    if(written && ftruncate(fd, mappingSize) == 0)
+    {
+        mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        errorMsg = "Cannot write the edge file next to the graph file.";
+        return false;
+    }
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+    pairs = (int*)mapping;
+
+    /*
+     * Dense ids are the ranks of the raw ids, as given by remapVertexIds.
+     */
+    vector<uint32_t> rankBefore(noWords);
+    originalIds.clear();
+    for(long long word=0;word<noWords;word++)
+    {
+        rankBefore[word] = originalIds.size();
+        for(uint64_t bits=present[word];bits;bits&=bits-1)
+        {
+            originalIds.push_back(minId + (word << 6) + __builtin_ctzll(bits));
+        }
+    }
+
+    noPasses++;
+    for(long long i=0;i<2*noPairs;i++)
+    {
+        long long offset = pairs[i] - minId;
+        pairs[i] = rankBefore[offset >> 6] + __builtin_popcountll(present[offset >> 6] & ((1ULL << (offset & 63)) - 1));
+    }
+
+    noVertices = max((long long)originalIds.size(), header[0]);
+    originalIds.resize(noVertices, 0);
+    return true;
+}
+
+bool SemiExternalScc::open(const char* fileName, bool cache, vector<long long>& header, vector<int>& originalIds, string& errorMsg)
+{
+    string snapshotFile = findSnapshot(fileName, cache);
+    if(!snapshotFile.empty())
+    {
+        if(!snapshot.open(snapshotFile.c_str(), SNAPSHOT_DIGRAPH))
+        {
+            errorMsg = "Invalid graph snapshot.";
+            return false;
+        }
+        header = snapshot.header();
+        noVertices = snapshot.noRows();
+        offsets = snapshot.offsets();
+        targets = snapshot.targets();
+        originalIds.assign(snapshot.values(), snapshot.values() + noVertices);
+    }
+    else if(!convertText(fileName, header, originalIds, errorMsg))
+    {
+        return false;
+    }
+
+    if(noVertices * SEMI_EXTERNAL_VERTEX_BYTES > memoryBudget)
+    {
+        errorMsg = "The memory budget cannot hold the per-vertex state of the graph.";
+        return false;
+    }
+    return true;
+}
+
+long long SemiExternalScc::countLiveEdges()
+{
+    PERF_REGION("semi-external:count");
+    fill(inDegree.begin(), inDegree.end(), 0);
+    fill(outDegree.begin(), outDegree.end(), 0);
+
+    long long noEdges = 0;
+    streamEdges([&](int x, int y)
+    {
+        if(x != y && representative[x] == -1 && representative[y] == -1)
+        {
+            outDegree[x]++;
+            inDegree[y]++;
+            noEdges++;
+        }
+    });
+    return noEdges;
+}
+
+int SemiExternalScc::trimVertices()
+{
+    PERF_REGION("semi-external:trim");
+    int noTrimmed = 0;
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        if(representative[vertex] == -1 && (inDegree[vertex] == 0 || outDegree[vertex] == 0))
+        {
+            representative[vertex] = vertex;
+            noTrimmed++;
+        }
+    }
+    noLive -= noTrimmed;
+    return noTrimmed;
+}
+
+void SemiExternalScc::searchPivot()
+{
+    PERF_REGION("semi-external:pivot");
+    const char FORWARD = 1, BACKWARD = 2;
+
+    int pivot = -1;
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        if(representative[vertex] == -1 && (pivot == -1 ||
+            (long long)inDegree[vertex] * outDegree[vertex] > (long long)inDegree[pivot] * outDegree[pivot]))
+        {
+            pivot = vertex;
+        }
+    }
+
+    fill(marks.begin(), marks.end(), 0);
+    marks[pivot] = FORWARD | BACKWARD;
+    for(bool changed=true;changed;)
+    {
+        changed = false;
+        streamEdges([&](int x, int y)
+        {
+            if(representative[x] != -1 || representative[y] != -1)
+            {
+                return;
+            }
+            if((marks[x] & FORWARD) && !(marks[y] & FORWARD))
+            {
+                marks[y] |= FORWARD;
+                changed = true;
+            }
+            if((marks[y] & BACKWARD) && !(marks[x] & BACKWARD))
+            {
+                marks[x] |= BACKWARD;
+                changed = true;
+            }
+        });
+    }
+
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        if(marks[vertex] == (FORWARD | BACKWARD))
+        {
+            representative[vertex] = pivot;
+            noLive--;
+        }
+    }
+}
+
+void SemiExternalScc::propagateColors()
+{
+    PERF_REGION("semi-external:colors");
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        color[vertex] = vertex;
+    }
+
+    for(bool changed=true;changed;)
+    {
+        changed = false;
+        streamEdges([&](int x, int y)
+        {
+            if(color[x] > color[y] && representative[x] == -1 && representative[y] == -1)
+            {
+                color[y] = color[x];
+                changed = true;
+            }
+        });
+    }
+
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        marks[vertex] = representative[vertex] == -1 && color[vertex] == vertex;
+    }
+
+    for(bool changed=true;changed;)
+    {
+        changed = false;
+        streamEdges([&](int x, int y)
+        {
+            if(marks[y] && !marks[x] && color[x] == color[y] && representative[x] == -1)
+            {
+                marks[x] = 1;
+                changed = true;
+            }
+        });
+    }
+
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        if(marks[vertex])
+        {
+            representative[vertex] = color[vertex];
+            noLive--;
+        }
+    }
+}
+
+void SemiExternalScc::solveResidue(long long noLiveEdges, ALG_TYPE alg, bool multistep, bool compress, ORDER_TYPE order)
+{
+    PERF_REGION("semi-external:residue");
+    vector<int> liveVertices;
+    liveVertices.reserve(noLive);
+    for(int vertex=0;vertex<noVertices;vertex++)
+    {
+        if(representative[vertex] == -1)
+        {
+            color[vertex] = liveVertices.size();
+            liveVertices.push_back(vertex);
+        }
+    }
+
+    vector<int> sources, destinations;
+    sources.reserve(noLiveEdges);
+    destinations.reserve(noLiveEdges);
+    streamEdges([&](int x, int y)
+    {
+        if(x != y && representative[x] == -1 && representative[y] == -1)
+        {
+            sources.push_back(color[x]);
+            destinations.push_back(color[y]);
+        }
+    });
+
+    DiGraph graph(noLive);
+    graph.setNoThreads(noThreads);
+    graph.setMultistep(multistep);
+    graph.setCompressed(compress);
+    graph.addEdges(sources, destinations);
+    if(order != ORDER_NONE)
+    {
+        graph.reorderVertices(order);
+    }
+    SccResult result = graph.getComponentLabels(alg);
+
+    for(int i=0;i<noLive;i++)
+    {
+        representative[liveVertices[i]] = liveVertices[result.vertices[result.offsets[result.componentOf[i]]]];
+    }
+    noLive = 0;
+}
+
+SccResult SemiExternalScc::getComponentLabels(ALG_TYPE alg, bool multistep, bool compress, ORDER_TYPE order)
+{
+    representative.assign(noVertices, -1);
+    inDegree.assign(noVertices, 0);
+    outDegree.assign(noVertices, 0);
+    color.assign(noVertices, 0);
+    marks.assign(noVertices, 0);
+    noLive = noVertices;
+
+    long long residueBudget = memoryBudget - noVertices * SEMI_EXTERNAL_VERTEX_BYTES;
+    long long noLiveEdges = countLiveEdges();
+    bool pivotSearched = false;
+    while(noLive > 0 && estimateInMemoryBytes(noLive, noLiveEdges) > residueBudget)
+    {
+        int noLeft = noLive;
+        int noTrimmed = trimVertices();
+        if(noTrimmed > 0 && (long long)noTrimmed * SEMI_EXTERNAL_TRIM_RATIO >= noLeft)
+        {
+            noLiveEdges = countLiveEdges();
+            continue;
+        }
+        if(noLive == 0)
+        {
+            break;
+        }
+
+        if(!pivotSearched)
+        {
+            searchPivot();
+            pivotSearched = true;
+        }
+        else
+        {
+            propagateColors();
+        }
+        noLiveEdges = countLiveEdges();
+    }
+
+    if(noLive > 0)
+    {
+        solveResidue(noLiveEdges, alg, multistep, compress, order);
+    }
+
+    vector<int>().swap(inDegree);
+    vector<int>().swap(outDegree);
+    vector<int>().swap(color);
+    vector<char>().swap(marks);
+
+    SccResult result;
+    collectComponents(noVertices, representative, result);
+    vector<int>().swap(representative);
+    return result;
+}
+
+long long SemiExternalScc::getNoPasses()
+{
+    return noPasses;
+}
@@ -0,0 +1,190 @@
+#ifndef semi_external_hpp
+#define semi_external_hpp
+
+#include<vector>
+#include<string>
+
+#include "scc.hpp"
+#include "graph_snapshot.hpp"
+
+/**
+ * \brief Returns an estimate of the bytes needed to find the components of a graph held
+ * in memory as a DiGraph, from loading its edges to collecting the components.
+ *
+ * @param noVertices - number of vertices
+ * @param noEdges - number of edges
+ */
+long long estimateInMemoryBytes(long long noVertices, long long noEdges);
+
+/**
+ * Class template for finding the strong components of a graph whose edges are streamed
+ * from disk, keeping only per-vertex state in memory.
+ *
+ * A text graph file is converted once into a binary file of edges next to it, which is
+ * memory-mapped and read sequentially by every pass, and removed when the object is
+ * destroyed. A binary snapshot is read in place.
+ *
+ * The passes follow the Multistep scheme. Vertices left without incoming or outgoing edges
+ * are trimmed, the component of the vertex of largest degree is found with a forward and a
+ * backward search, and Orzan's colour propagation then finds the components of the
+ * largest remaining colours. Every search makes a pass over the edges until no vertex
+ * changes, applying the changes within a pass. The components found are contracted away,
+ * and once the edges between the remaining vertices fit in the memory budget they are
+ * loaded into a DiGraph, and solved by the chosen algorithm.
+ */
+class SemiExternalScc
+{
+    private:
+        /**
+         * Number of vertices, and number of them whose component is not found yet.
+         */
+        int noVertices;
+        int noLive;
+
+        /**
+         * Memory budget in bytes.
+         */
+        long long memoryBudget;
+
+        /**
+         * Number of threads used by the in-memory algorithm.
+         */
+        int noThreads;
+
+        /**
+         * CSR arrays of a snapshot read in place, or nullptr.
+         */
+        GraphSnapshot snapshot;
+        const int* offsets;
+        const int* targets;
+
+        /**
+         * Mapping of the binary edge file, holding the source and the destination of every edge.
+         */
+        int* pairs;
+        long long noPairs;
+
+        /**
+         * Number of passes made over the edges.
+         */
+        long long noPasses;
+
+        /**
+         * A vertex of its component for every vertex whose component is found, and -1 otherwise.
+         */
+        std::vector<int> representative;
+
+        /**
+         * Number of edges between vertices whose component is not found, entering and leaving
+         * every vertex, as of the last count.
+         */
+        std::vector<int> inDegree, outDegree;
+
+        /**
+         * Colour of every vertex, and search marks.
+         */
+        std::vector<int> color;
+        std::vector<char> marks;
+
+        /**
+         * \brief Calls visit(x, y) for every edge x -> y, in one pass over the edges.
+         */
+        template<class Visit>
+        void streamEdges(Visit visit);
+
+        /**
+         * \brief Converts a text graph file into the binary edge file, mapping its vertex ids
+         * to dense ids assigned in increasing order, and returns whether it succeeded.
+         *
+         * @param fileName - path of the graph file
+         * @param header - filled with the numbers on the header line
+         * @param originalIds - filled with the raw id of every dense id
+         * @param errorMsg - set to the cause of a failure
+         */
+        bool convertText(const char* fileName, std::vector<long long>& header, std::vector<int>& originalIds,
+            std::string& errorMsg);
+
+        /**
+         * \brief Counts the edges between vertices whose component is not found, and the
+         * degrees of those vertices, and returns the number of edges.
+         */
+        long long countLiveEdges();
+
+        /**
+         * \brief Makes every vertex without incoming or outgoing edges a component of its
+         * own, and returns the number of them.
+         */
+        int trimVertices();
+
+        /**
+         * \brief Finds the component of the vertex of largest degree, with a forward and a
+         * backward search.
+         */
+        void searchPivot();
+
+        /**
+         * \brief Propagates the largest colour along the edges, and finds the component of
+         * every vertex whose colour is its own, with a backward search among the vertices
+         * of that colour.
+         */
+        void propagateColors();
+
+        /**
+         * \brief Loads the edges between the vertices whose component is not found into a
+         * DiGraph, and finds their components with the given algorithm.
+         *
+         * @param noLiveEdges - number of edges between those vertices
+         * @param alg - algorithm used for finding the components
+         * @param multistep - whether the Multistep preprocessing is run before alg
+         * @param compress - whether alg runs on compressed adjacencies
+         * @param order - order in which the vertices are relabelled before running alg
+         */
+        void solveResidue(long long noLiveEdges, ALG_TYPE alg, bool multistep, bool compress, ORDER_TYPE order);
+
+    public:
+        /**
+         * \brief Creates a solver limited to a memory budget.
+         *
+         * @param memoryBudget - memory budget in bytes
+         * @param noThreads - number of threads used by the in-memory algorithm
+         */
+        SemiExternalScc(long long memoryBudget, int noThreads);
+
+        /**
+         * \brief Unmaps and removes the binary edge file.
+         */
+        ~SemiExternalScc();
+
+        SemiExternalScc(const SemiExternalScc&) = delete;
+        SemiExternalScc& operator=(const SemiExternalScc&) = delete;
+
+        /**
+         * \brief Opens a graph file, as text or as a binary snapshot, and returns whether it
+         * succeeded, setting errorMsg otherwise.
+         *
+         * @param fileName - path of the graph file
+         * @param cache - whether a cached snapshot of a text file is used, if one exists
+         * @param header - filled with the numbers on the header line of the graph file
+         * @param originalIds - filled with the raw id of every vertex
+         * @param errorMsg - set to the cause of a failure
+         */
+        bool open(const char* fileName, bool cache, std::vector<long long>& header, std::vector<int>& originalIds,
+            std::string& errorMsg);
+
+        /**
+         * \brief Finds the strong components of the graph.
+         *
+         * @param alg - algorithm used once the remaining edges fit in memory
+         * @param multistep - whether the Multistep preprocessing is run by that algorithm
+         * @param compress - whether that algorithm runs on compressed adjacencies
+         * @param order - order in which the remaining vertices are relabelled before running it
+         */
+        SccResult getComponentLabels(ALG_TYPE alg, bool multistep, bool compress, ORDER_TYPE order);
+
+        /**
+         * \brief Returns the number of passes made over the edges, including the conversion.
+         */
+        long long getNoPasses();
+};
+
+#endif
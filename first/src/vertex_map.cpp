@@ -0,0 +1,141 @@
+#include<vector>
+#include<algorithm>
+#include<functional>
+
+#include "vertex_map.hpp"
+#include "thread_pool.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+/**
+ * Number of values below which sorting and mapping run on a single thread.
+ */
+const int PARALLEL_REMAP = 1 << 20;
+
+/**
+ * Grain of the parallel loops over the edges.
+ */
+const int REMAP_GRAIN = 1 << 16;
+
+
+void parallelSort(vector<int>& values, ThreadPool& pool)
+{
+    int n = values.size(), noRuns = pool.size();
+    if(noRuns == 1 || n < PARALLEL_REMAP)
+    {
+        sort(values.begin(), values.end());
+        return;
+    }
+
+    vector<int> bounds(noRuns + 1);
+    for(int i=0;i<=noRuns;i++)
+    {
+        bounds[i] = (long long)n * i / noRuns;
+    }
+
+    pool.parallelFor(0, noRuns, 1, [&](int begin, int end)
+    {
+        for(int i=begin;i<end;i++)
+        {
+            sort(values.begin() + bounds[i], values.begin() + bounds[i+1]);
+        }
+    });
+
+    for(int width=1;width<noRuns;width*=2)
+    {
+        int noMerges = (noRuns + 2 * width - 1) / (2 * width);
+        pool.parallelFor(0, noMerges, 1, [&](int begin, int end)
+        {
+            for(int i=begin;i<end;i++)
+            {
+                int first = 2 * width * i;
+                int middle = min(first + width, noRuns), last = min(first + 2 * width, noRuns);
+                inplace_merge(values.begin() + bounds[first], values.begin() + bounds[middle],
+                    values.begin() + bounds[last]);
+            }
+        });
+    }
+}
+
+int remapVertexIds(vector<int>& sources, vector<int>& targets, vector<int>& originalIds, int noThreads)
+{
+    PERF_REGION("remap");
+    int noEndpoints = sources.size() + targets.size();
+    ThreadPool pool(noEndpoints < PARALLEL_REMAP ? 1 : noThreads);
+
+    originalIds.clear();
+    if(!noEndpoints)
+    {
+        return 0;
+    }
+
+    int smallest = min(*min_element(sources.begin(), sources.end()), *min_element(targets.begin(), targets.end()));
+    int largest = max(*max_element(sources.begin(), sources.end()), *max_element(targets.begin(), targets.end()));
+    long long range = (long long)largest - smallest + 1;
+
+    vector<int> denseId;
+    auto mapEdges = [&](const function<int(int)>& lookup)
+    {
+        vector<int>* columns[2] = {&sources, &targets};
+        for(auto column : columns)
+        {
+            pool.parallelFor(0, column->size(), REMAP_GRAIN, [&](int begin, int end)
+            {
+                for(int i=begin;i<end;i++)
+                {
+                    (*column)[i] = lookup((*column)[i]);
+                }
+            });
+        }
+    };
+
+    if(range <= 2LL * noEndpoints)
+    {
+        denseId.assign(range, -1);
+        for(auto x : sources)
+        {
+            denseId[x - smallest] = 0;
+        }
+        for(auto y : targets)
+        {
+            denseId[y - smallest] = 0;
+        }
+
+        for(long long i=0;i<range;i++)
+        {
+            if(!denseId[i])
+            {
+                denseId[i] = originalIds.size();
+                originalIds.push_back(smallest + i);
+            }
+        }
+
+        mapEdges([&](int id) { return denseId[id - smallest]; });
+        return originalIds.size();
+    }
+
+    originalIds.reserve(noEndpoints);
+    originalIds.insert(originalIds.end(), sources.begin(), sources.end());
+    originalIds.insert(originalIds.end(), targets.begin(), targets.end());
+    parallelSort(originalIds, pool);
+    originalIds.erase(unique(originalIds.begin(), originalIds.end()), originalIds.end());
+    originalIds.shrink_to_fit();
+
+    mapEdges([&](int id) { return lower_bound(originalIds.begin(), originalIds.end(), id) - originalIds.begin(); });
+    return originalIds.size();
+}
+
+void lookupVertexIds(const int* originalIds, int noIds, vector<int>& ids, int noThreads)
+{
+    ThreadPool pool(ids.size() < PARALLEL_REMAP ? 1 : noThreads);
+    pool.parallelFor(0, ids.size(), REMAP_GRAIN, [&](int begin, int end)
+    {
+        for(int i=begin;i<end;i++)
+        {
+            const int* found = lower_bound(originalIds, originalIds + noIds, ids[i]);
+            ids[i] = found != originalIds + noIds && *found == ids[i] ? found - originalIds : -1;
+        }
+    });
+}
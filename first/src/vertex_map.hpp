@@ -0,0 +1,45 @@
+#ifndef vertex_map_hpp
+#define vertex_map_hpp
+
+#include<vector>
+
+class ThreadPool;
+
+/**
+ * \brief Sorts a list of integers, splitting it into sorted runs that are merged
+ * pairwise in parallel for large inputs.
+ *
+ * @param values - list to be sorted
+ * @param pool - thread pool used to sort and merge the runs
+ */
+void parallelSort(std::vector<int>& values, ThreadPool& pool);
+
+/**
+ * \brief Maps the raw vertex ids of an edge list to dense ids, assigned in increasing
+ * order of the raw ids.
+ *
+ * If the raw ids fit in a range not much larger than the edge list, they are mapped by
+ * direct indexing into a table over that range. Otherwise the ids are collected, sorted
+ * and deduplicated, and every endpoint is mapped by binary search.
+ *
+ * Returns the number of distinct vertices.
+ *
+ * @param sources - raw sources of the edges, replaced by their dense ids
+ * @param targets - raw destinations of the edges, replaced by their dense ids
+ * @param originalIds - filled with the raw id of every dense id
+ * @param noThreads - number of threads used for sorting and mapping
+ */
+int remapVertexIds(std::vector<int>& sources, std::vector<int>& targets, std::vector<int>& originalIds, int noThreads);
+
+/**
+ * \brief Maps raw vertex ids to the dense ids assigned by remapVertexIds, by binary search.
+ * Raw ids which do not belong to the digraph are mapped to -1.
+ *
+ * @param originalIds - raw id of every dense id, in increasing order
+ * @param noIds - number of dense ids
+ * @param ids - raw ids, replaced by their dense ids
+ * @param noThreads - number of threads used for mapping
+ */
+void lookupVertexIds(const int* originalIds, int noIds, std::vector<int>& ids, int noThreads);
+
+#endif
@@ -0,0 +1,301 @@
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<cstring>
+#include<cstdlib>
+#include<vector>
+#include<memory>
+#include<algorithm>
+#include<thread>
+
+#include "flow_graph.hpp"
+#include "ff.hpp"
+#include "hopcroft_karp.hpp"
+#include "vertex_order.hpp"
+#include "edge_loader.hpp"
+#include "graph_generators.hpp"
+#include "benchmark.hpp"
+
+using namespace std;
+
+
+/**
+ * Names of the engines.
+ */
+const char* const ENGINE_NAMES[] = {"ff", "push_relabel", "dinic", "parallel_push_relabel", "hopcroft_karp"};
+const int NO_ENGINES = 5;
+
+
+static void displayBenchError(string errorMsg)
+{
+    cerr<<"Error - "<<errorMsg<<endl;
+    cerr<<"Usage -\n\t./ffBench task graph... [--alg algs] [--warmup n] [--runs n] [--threads n] [--max-capacity n]"
+        " [--back p] [--seed n] [--format format] [--output outputFile]"<<endl<<endl;
+    cerr<<"\ttask - max_flow or bipartite_matching"<<endl;
+    cerr<<"\tgraph - file:graphFile, or for max_flow rmat:SCALE:EDGEFACTOR, er:V:E or grid:ROWS:COLS,"
+        " or for bipartite_matching bipartite:N1:N2:E"<<endl;
+    cerr<<"\t--alg algs - comma separated algorithms to run (ff, push_relabel, dinic, parallel_push_relabel"
+        " or hopcroft_karp, defaults to all that solve the task)"<<endl;
+    cerr<<"\t--warmup n - untimed runs before the timed ones (defaults to 1)"<<endl;
+    cerr<<"\t--runs n - timed runs (defaults to 5)"<<endl;
+    cerr<<"\t--threads n - number of threads used by parallel algorithms (defaults to all cores)"<<endl;
+    cerr<<"\t--max-capacity n - capacities of generated flow networks are drawn from 1 .. n (defaults to 100)"<<endl;
+    cerr<<"\t--back p - direct generated edges from smaller to larger vertex, reversing each with probability p"<<endl;
+    cerr<<"\t--seed n - seed of the generators (defaults to 1)"<<endl;
+    cerr<<"\t--format format - csv, json or results (the lines of the results files, defaults to csv)"<<endl;
+    cerr<<"\t--output outputFile - file written instead of the standard output, appended to for results"<<endl;
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * \brief A flow problem read or generated once, from which a fresh flow network is built
+ * before every run.
+ */
+struct FlowProblem
+{
+    std::string name;
+    EdgeList edges;
+    int V, s, t;
+    long long noVertices, noEdges;
+    bool bipartite;
+
+    long long minCapacity, maxCapacity;
+
+    template<class Index, class Capacity>
+    std::unique_ptr<FlowGraph<Index, Capacity> > build() const
+    {
+        std::unique_ptr<FlowGraph<Index, Capacity> > graph(new FlowGraph<Index, Capacity>(V));
+        if (!bipartite)
+        {
+            for (int i = 0; i < edges.noEdges(); i++)
+            {
+                graph->addEdge(edges.columns[0][i], edges.columns[1][i], edges.weights[i]);
+            }
+            graph->buildArcs();
+            return graph;
+        }
+
+        int n1 = edges.header[0], n = V - 2;
+        for (int i = 0; i < edges.noEdges(); i++) { graph->addEdge(edges.columns[0][i] - 1, edges.columns[1][i] - 1 + n1, 1); }
+        for (int v = 0; v < n1; v++) { graph->addEdge(s, v, 1); }
+        for (int v = n1; v < n; v++) { graph->addEdge(v, t, 1); }
+        graph->buildArcs();
+        return graph;
+    }
+};
+
+/**
+ * \brief Loads or generates a flow problem given on the command line.
+ *
+ * The source and the sink of a file are found as ff finds them. Those of a generated flow
+ * network are the vertices with the largest and the smallest out-degree less in-degree,
+ * which are the corners of a grid and usually hubs of an R-MAT graph.
+ */
+static void loadProblem(const char* spec, bool bipartite, const GeneratorOptions& options, FlowProblem& problem)
+{
+    problem.bipartite = bipartite;
+    bool fromFile = !strncmp(spec, "file:", 5);
+    if (fromFile)
+    {
+        problem.name = spec + 5;
+        if (!loadEdgeList(spec + 5, bipartite ? 3 : 2, 2, problem.edges, 0, !bipartite))
+        {
+            displayBenchError("Cannot open graph file " + problem.name + ".");
+        }
+    }
+    else if (!generateGraph(spec, options, problem.edges, problem.name) || problem.edges.header.size() != (bipartite ? 3u : 2u))
+    {
+        displayBenchError(string("Invalid graph ") + spec + ".");
+    }
+
+    const vector<long long>& header = problem.edges.header;
+    if (bipartite)
+    {
+        int n = header[0] + header[1];
+        problem.V = n + 2;
+        problem.s = n;
+        problem.t = n + 1;
+        problem.noVertices = n;
+        problem.noEdges = header[2];
+        problem.minCapacity = problem.maxCapacity = 1;
+        return;
+    }
+
+    problem.V = header[0];
+    problem.noVertices = header[0];
+    problem.noEdges = header[1];
+    const vector<long long>& capacities = problem.edges.weights;
+    problem.minCapacity = capacities.empty() ? 0 : *min_element(capacities.begin(), capacities.end());
+    problem.maxCapacity = capacities.empty() ? 0 : *max_element(capacities.begin(), capacities.end());
+    if (fromFile)
+    {
+        unique_ptr<FlowGraph<uint32_t, int32_t> > graph = problem.build<uint32_t, int32_t>();
+        problem.s = graph->source();
+        problem.t = graph->sink();
+        return;
+    }
+
+    vector<int> surplus(problem.V, 0);
+    for (int i = 0; i < problem.edges.noEdges(); i++)
+    {
+        surplus[problem.edges.columns[0][i]]++;
+        surplus[problem.edges.columns[1][i]]--;
+    }
+    problem.s = max_element(surplus.begin(), surplus.end()) - surplus.begin();
+    problem.t = min_element(surplus.begin(), surplus.end()) - surplus.begin();
+    if (problem.s == problem.t) { problem.t = (problem.s + 1) % problem.V; }
+}
+
+int main(int argc, char** argv)
+{
+    vector<char*> args;
+    vector<bool> engines(NO_ENGINES, true);
+    bool algGiven = false;
+    int noWarmup = 1, noRuns = 5;
+    int noThreads = max((int)thread::hardware_concurrency(), 1);
+    GeneratorOptions options;
+    options.maxCapacity = 100;
+    BENCH_FORMAT format = BENCH_CSV;
+    char* outputFile = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--alg"))
+        {
+            if (i + 1 == argc) { displayBenchError("Missing algorithms."); }
+
+            string names = string(argv[++i]) + ",";
+            algGiven = true;
+            fill(engines.begin(), engines.end(), false);
+            for (size_t start = 0, comma; (comma = names.find(',', start)) != string::npos; start = comma + 1)
+            {
+                int engine = find(ENGINE_NAMES, ENGINE_NAMES + NO_ENGINES, names.substr(start, comma - start)) - ENGINE_NAMES;
+                if (engine == NO_ENGINES) { displayBenchError("Unknown algorithm."); }
+                engines[engine] = true;
+            }
+        }
+        else if (!strcmp(argv[i], "--warmup"))
+        {
+            if (i + 1 == argc || (noWarmup = atoi(argv[++i])) < 0) { displayBenchError("Invalid number of warmup runs."); }
+        }
+        else if (!strcmp(argv[i], "--runs"))
+        {
+            if (i + 1 == argc || (noRuns = atoi(argv[++i])) < 1) { displayBenchError("Invalid number of runs."); }
+        }
+        else if (!strcmp(argv[i], "--threads"))
+        {
+            if (i + 1 == argc || (noThreads = atoi(argv[++i])) < 1) { displayBenchError("Invalid number of threads."); }
+        }
+        else if (!strcmp(argv[i], "--max-capacity"))
+        {
+            if (i + 1 == argc || (options.maxCapacity = atoi(argv[++i])) < 1) { displayBenchError("Invalid maximum capacity."); }
+        }
+        else if (!strcmp(argv[i], "--back"))
+        {
+            if (i + 1 == argc || (options.backProbability = atof(argv[++i])) < 0 || options.backProbability > 1)
+            {
+                displayBenchError("Invalid back-edge probability.");
+            }
+        }
+        else if (!strcmp(argv[i], "--seed"))
+        {
+            if (i + 1 == argc) { displayBenchError("Missing seed."); }
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--format"))
+        {
+            if (i + 1 == argc || !parseBenchFormat(argv[++i], format)) { displayBenchError("Unknown output format."); }
+        }
+        else if (!strcmp(argv[i], "--output"))
+        {
+            if (i + 1 == argc) { displayBenchError("Missing output file."); }
+            outputFile = argv[++i];
+        }
+        else { args.push_back(argv[i]); }
+    }
+
+    if (args.size() < 2) { displayBenchError("No. of command-line arguments do not match."); }
+
+    bool bipartite = !strcmp(args[0], "bipartite_matching");
+    if (!bipartite && strcmp(args[0], "max_flow")) { displayBenchError("Incorrect command line argument"); }
+    if (bipartite) { options.maxCapacity = 0; }
+
+    /*
+     * HopcroftKarp has no flow network, and is left out of max_flow unless it is asked for.
+     */
+    int hopcroftKarp = find(ENGINE_NAMES, ENGINE_NAMES + NO_ENGINES, string("hopcroft_karp")) - ENGINE_NAMES;
+    if (!bipartite && engines[hopcroftKarp])
+    {
+        if (algGiven) { displayBenchError("hopcroft_karp only solves bipartite_matching."); }
+        engines[hopcroftKarp] = false;
+    }
+
+    if (format == BENCH_RESULTS && count(engines.begin(), engines.end(), true) > 1)
+    {
+        displayBenchError("The results format takes a single algorithm, as every results file holds one.");
+    }
+
+    vector<BenchRecord> records;
+    for (size_t i = 1; i < args.size(); i++)
+    {
+        FlowProblem problem;
+        loadProblem(args[i], bipartite, options, problem);
+
+        for (int engine = 0; engine < NO_ENGINES; engine++)
+        {
+            if (!engines[engine]) { continue; }
+
+            BenchRecord record;
+            record.graph = problem.name;
+            record.engine = ENGINE_NAMES[engine];
+            record.noVertices = problem.noVertices;
+            record.noEdges = problem.noEdges;
+            record.noThreads = 1;
+
+            long long flow = 0;
+            if (engine == hopcroftKarp)
+            {
+                vector<int> offsets, targets;
+                buildEdgeCSR(problem.edges.header[0], problem.edges.columns[0], problem.edges.columns[1], 1, offsets, targets);
+                runBenchmark(noWarmup, noRuns, []() {}, [&]()
+                {
+                    flow = HopcroftKarp(problem.edges.header[0], problem.edges.header[1], offsets.data(), targets.data()).size();
+                }, record);
+            }
+            else
+            {
+                dispatchFlowTypes(problem.minCapacity, problem.maxCapacity, [&](auto types)
+                {
+                    typedef typename decltype(types)::Index Index;
+                    typedef typename decltype(types)::Capacity Capacity;
+
+                    FLOW_ALG_TYPE alg;
+                    parseFlowAlg(ENGINE_NAMES[engine], alg);
+                    if (alg == FLOW_PARALLEL_PUSH_RELABEL) { record.noThreads = noThreads; }
+                    dispatchFlowAlg<Index, Capacity>(alg, noThreads, [&](auto solver)
+                    {
+                        unique_ptr<FlowGraph<Index, Capacity> > graph;
+                        runBenchmark(noWarmup, noRuns, [&]() { graph = problem.build<Index, Capacity>(); },
+                            [&]() { flow = solver.run(graph.get(), (Index)problem.s, (Index)problem.t).flow(); }, record);
+                    });
+                });
+            }
+
+            record.values.push_back(make_pair("flow", flow));
+            records.push_back(record);
+
+            cerr<<problem.name<<" "<<record.engine<<" - median "<<percentile(record.wallTimes, 50)<<" seconds"<<endl;
+        }
+    }
+
+    if (!outputFile)
+    {
+        writeBenchRecords(cout, records, format);
+        return 0;
+    }
+
+    ofstream out(outputFile, format == BENCH_RESULTS ? ios_base::app : ios_base::trunc);
+    if (!out.is_open()) { displayBenchError("Cannot open output file."); }
+    writeBenchRecords(out, records, format);
+
+    return 0;
+}
@@ -20,12 +20,10 @@ then
 	prefix="bm"
 fi
 
-for graph in $(ls graphs)
-do
-	if [[ $graph =~ ^$prefix ]]
-	then
-		echo "Running graph - $graph"
-		./bin/ff $1 "./graphs/$graph" $2 >/dev/null
-		exit_if_error
-	fi
-done
\ No newline at end of file
+manifest=$(mktemp)
+ls graphs | grep "^$prefix" | sed "s#^#$PWD/graphs/#" > $manifest
+
+./bin/ff $1 $manifest $2 --batch
+status=$?
+rm -f $manifest
+exit $status
@@ -0,0 +1,179 @@
+#include<vector>
+#include<algorithm>
+#include<limits>
+#include<string>
+#include<cstdint>
+
+#include "dinic.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+template<class Index, class Capacity>
+Dinic<Index, Capacity>::Dinic(Graph* G, Index s, Index t)
+{
+    G->buildArcs();
+    V = G->noVertices();
+    level.assign(V, V);
+    currentArc.resize(V);
+
+    initDelta(G);
+    flo = 0;
+    while (delta >= 1)
+    {
+        PERF_REGION("scaling phase delta=" + to_string(delta));
+        while (buildLevelGraph(G, s, t))
+        {
+            blockingFlow(G, s, t);
+        }
+        delta /= 2;
+    }
+}
+
+template<class Index, class Capacity>
+void Dinic<Index, Capacity>::initDelta(Graph* G)
+{
+    long long upperLimit = 0;
+    for (Arc a = 0; a < G->noArcs(); a++)
+    {
+        upperLimit = max(upperLimit, (long long)G->residual(a));
+    }
+
+    long long power = 1;
+    while (power <= upperLimit >> 1)
+    {
+        power = power << 1;
+    }
+    delta = upperLimit ? power : 0;
+}
+
+template<class Index, class Capacity>
+bool Dinic<Index, Capacity>::buildLevelGraph(Graph* G, Index s, Index t)
+{
+    PERF_REGION("dinic:level graph");
+    fill(level.begin(), level.end(), V);
+    for (Index v = 0; v < V; v++)
+    {
+        currentArc[v] = G->firstArc(v);
+    }
+
+    /*
+     * Vertices on the level of the sink or above are not expanded, as no edge of the
+     * level graph leaves them towards the sink.
+     */
+    vector<Index> order(1, s);
+    level[s] = 0;
+    for (size_t i = 0; i < order.size() && level[order[i]] < level[t]; i++)
+    {
+        Index v = order[i];
+        for (Arc a = G->firstArc(v); a < G->endArc(v); a++)
+        {
+            Index w = G->head(a);
+            if (level[w] == V && G->residual(a) >= delta)
+            {
+                level[w] = level[v] + 1;
+                order.push_back(w);
+            }
+        }
+    }
+    return level[t] != V;
+}
+
+template<class Index, class Capacity>
+void Dinic<Index, Capacity>::blockingFlow(Graph* G, Index s, Index t)
+{
+    PERF_REGION("dinic:blocking flow");
+
+    /*
+     * The search keeps the path from the source as a stack of vertices, and the arcs
+     * between them.
+     */
+    vector<Index> path(1, s);
+    vector<Arc> pathArcs;
+    while (true)
+    {
+        Index v = path.back();
+        if (v == t)
+        {
+            Capacity bottleneck = numeric_limits<Capacity>::max();
+            for (Arc a : pathArcs)
+            {
+                bottleneck = min(bottleneck, G->residual(a));
+            }
+
+            for (Arc a : pathArcs)
+            {
+                G->push(a, bottleneck);
+            }
+            flo += bottleneck;
+
+            /*
+             * The search resumes from the tail of the first arc left below delta.
+             */
+            size_t k = 0;
+            while (k < pathArcs.size() && G->residual(pathArcs[k]) >= delta) { k++; }
+            pathArcs.resize(k);
+            path.resize(k + 1);
+            continue;
+        }
+
+        for (Arc end = G->endArc(v); currentArc[v] < end; currentArc[v]++)
+        {
+            Arc a = currentArc[v];
+            Index w = G->head(a);
+            if (level[w] == level[v] + 1 && G->residual(a) >= delta)
+            {
+                path.push_back(w);
+                pathArcs.push_back(a);
+                break;
+            }
+        }
+        if (path.back() != v) { continue; }
+
+        /*
+         * No arc leads on from v, which is removed from the level graph.
+         */
+        if (v == s) { break; }
+        level[v] = V;
+        path.pop_back();
+        pathArcs.pop_back();
+        currentArc[path.back()]++;
+    }
+}
+
+template<class Index, class Capacity>
+long long Dinic<Index, Capacity>::flow()
+{
+    return flo;
+}
+
+template<class Index, class Capacity>
+bool Dinic<Index, Capacity>::inCut(Index v)
+{
+    /*
+     * The last level graph, of delta 1, holds every vertex reachable from the source.
+     */
+    return level[v] != V;
+}
+
+template<class Index, class Capacity>
+vector<Index> Dinic<Index, Capacity>::getCut()
+{
+    vector<Index> cut;
+    for (Index i = 0; i < V; i++)
+    {
+        if (inCut(i)) { cut.push_back(i); }
+    }
+
+    return cut;
+}
+
+
+/*
+ * The instantiations picked by dispatchFlowTypes.
+ */
+#define INSTANTIATE_DINIC(Index, Capacity) \
+    template class Dinic<Index, Capacity>;
+
+FOR_EACH_FLOW_TYPES(INSTANTIATE_DINIC)
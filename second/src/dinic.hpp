@@ -0,0 +1,111 @@
+#ifndef dinic_hpp
+#define dinic_hpp
+
+#include<vector>
+#include "flow_graph.hpp"
+
+/**
+ * Class template for Dinic's maximum flow algorithm with capacity scaling, with the same
+ * interface as FordFulkerson.
+ *
+ * Every scaling phase only uses residual edges of at least delta. Within a phase, a BFS
+ * from the source labels every vertex with its distance (the level graph), and a blocking
+ * flow is pushed through the edges going one level up by depth-first searches that resume
+ * at a current-arc pointer per vertex, so every edge is passed over at most once per level
+ * graph. A phase ends when the sink is no longer reachable, and the algorithm when the
+ * phase of delta 1 does.
+ */
+template<class Index, class Capacity>
+class Dinic
+{
+    private:
+        typedef FlowGraph<Index, Capacity> Graph;
+        typedef typename Graph::Arc Arc;
+
+        /**
+         * Number of vertices in the digraph.
+         */
+        Index V;
+
+        /**
+         * The value of the flow in the network at a given state.
+         */
+        long long flo;
+
+        /**
+         * scaling parameter to speed up the algorithm.
+         */
+        Capacity delta;
+
+        /**
+         * Distance of every vertex from the source in the level graph, V if it is not
+         * reached or cannot reach the sink any more.
+         */
+        std::vector<Index> level;
+
+        /**
+         * Next arc the search leaves every vertex by.
+         */
+        std::vector<Arc> currentArc;
+
+        /**
+         * \brief Used to initialize delta to the largest power of 2
+         * less than the maximum capacity of an edge in the network.
+         *
+         * @param G - pointer to the flow network
+         */
+        void initDelta(Graph* G);
+
+        /**
+         * \brief Builds the level graph of the residual edges of at least delta, and returns
+         * whether the sink is in it.
+         *
+         * @param G - pointer to the flow network
+         * @param s - source vertex
+         * @param t - sink/target vertex
+         */
+        bool buildLevelGraph(Graph* G, Index s, Index t);
+
+        /**
+         * \brief Pushes a blocking flow through the level graph.
+         *
+         * @param G - pointer to the flow network
+         * @param s - source vertex
+         * @param t - sink/target vertex
+         */
+        void blockingFlow(Graph* G, Index s, Index t);
+
+    public:
+        /**
+         * \brief Constructor used for Dinic object.
+         *
+         * The constructor also runs the algorithm and finds the maximum flow, and the
+         * minimum cut solutions.
+         *
+         * @param G - pointer to the flow network
+         * @param s - source vertex
+         * @param t - sink/target vertex
+         */
+        Dinic(Graph* G, Index s, Index t);
+
+        /**
+         * \brief Returns the max-flow value calculated by the algorithm.
+         */
+        long long flow();
+
+        /**
+         * \brief Returns whether the vertex passed is in the given ST Cut
+         * (in the source set)
+         *
+         * @param v - vertex to be checked
+         */
+        bool inCut(Index v);
+
+        /**
+         * \brief Returns a vector of vertices present in the source set of
+         * the min cut.
+         */
+        std::vector<Index> getCut();
+};
+
+#endif
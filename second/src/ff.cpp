@@ -5,14 +5,24 @@
 #include<string>
 #include<iostream>
 #include<fstream>
-#include<sstream>
 #include<unordered_map>
 #include<iomanip>
 #include <string.h>
 #include<stdexcept>
+#include<memory>
+#include<sstream>
+#include<thread>
 
 #include "flow_graph.hpp"
+#include "push_relabel.hpp"
+#include "dinic.hpp"
+#include "hopcroft_karp.hpp"
 #include "ff.hpp"
+#include "edge_loader.hpp"
+#include "graph_snapshot.hpp"
+#include "vertex_order.hpp"
+#include "perf_counters.hpp"
+#include "batch_runner.hpp"
 
 
 using namespace std;
@@ -23,69 +33,73 @@ using namespace std;
 #define FIXED_FLOAT(x, y) fixed<<setprecision(y)<<(x)
 
 
-const int MAX_INT = numeric_limits<int>::max();
-
-
-FordFulkerson::FordFulkerson(FlowGraph* G, int s, int t)
+template<class Index, class Capacity>
+FordFulkerson<Index, Capacity>::FordFulkerson(Graph* G, Index s, Index t)
 {
+    G->buildArcs();
     V = G->noVertices();
     visited.resize(V);
-    parentEdge.resize(V);
+    parentArc.resize(V);
 
     initDelta(G);
     flo = 0;
     while (delta >= 1)
     {
+        PERF_REGION("scaling phase delta=" + to_string(delta));
         while (hasAugmentingPath(G, s, t))
         {
-            augment(s, t);
+            augment(G, s, t);
         }
         delta /= 2;
     }
-    fill(parentEdge.begin(), parentEdge.end(), nullptr);
 }
 
-void FordFulkerson::initDelta(FlowGraph* G)
+template<class Index, class Capacity>
+void FordFulkerson<Index, Capacity>::initDelta(Graph* G)
 {
-    delta = 1;
-
-    int upperLimit = 0;
-    for (int i = 0; i < V; i++)
+    /*
+     * No flow has been pushed yet, so the residual capacities of the arcs are the
+     * capacities of the edges, and 0.
+     */
+    long long upperLimit = 0;
+    for (Arc a = 0; a < G->noArcs(); a++)
     {
-        for (FlowEdge* e : G->adj(i))
-        {
-            upperLimit = max(upperLimit, e->capacity());
-        }
+        upperLimit = max(upperLimit, (long long)G->residual(a));
     }
 
-    while (delta <= upperLimit)
+    /*
+     * The largest power of 2 not above upperLimit, found without doubling past it, which
+     * could overflow Capacity.
+     */
+    long long power = 1;
+    while (power <= upperLimit >> 1)
     {
-        delta = delta << 1;
+        power = power << 1;
     }
-    delta = delta >> 1;
+    delta = upperLimit ? power : 0;
 }
 
-bool FordFulkerson::hasAugmentingPath(FlowGraph* G, int s, int t)
+template<class Index, class Capacity>
+bool FordFulkerson<Index, Capacity>::hasAugmentingPath(Graph* G, Index s, Index t)
 {
     fill(visited.begin(), visited.end(), false);
 
-    queue<int> q;
+    queue<Index> q;
     q.push(s);
     visited[s] = true;
-    parentEdge[s] = nullptr;
     while (!q.empty())
     {
-        int v = q.front();
+        Index v = q.front();
         q.pop();
 
         if (v == t) { break; }
 
-        for (FlowEdge* e : G->adj(v))
+        for (Arc a = G->firstArc(v); a < G->endArc(v); a++)
         {
-            int w = e->other(v);
-            if (e->residualCapacityTo(w) >= delta && !visited[w])
+            Index w = G->head(a);
+            if (G->residual(a) >= delta && !visited[w])
             {
-                parentEdge[w] = e;
+                parentArc[w] = a;
                 visited[w] = true;
                 q.push(w);
             }
@@ -94,36 +108,40 @@ bool FordFulkerson::hasAugmentingPath(FlowGraph* G, int s, int t)
     return visited[t];
 }
 
-void FordFulkerson::augment(int s, int t)
+template<class Index, class Capacity>
+void FordFulkerson<Index, Capacity>::augment(Graph* G, Index s, Index t)
 {
-    int bottleneck = MAX_INT;
-    for (int v = t; v != s; v = parentEdge[v]->other(v))
+    Capacity bottleneck = numeric_limits<Capacity>::max();
+    for (Index v = t; v != s; v = G->head(G->reverse(parentArc[v])))
     {
-        bottleneck = min(bottleneck, parentEdge[v]->residualCapacityTo(v));
+        bottleneck = min(bottleneck, G->residual(parentArc[v]));
     }
 
-    for (int v = t; v != s; v = parentEdge[v]->other(v))
+    for (Index v = t; v != s; v = G->head(G->reverse(parentArc[v])))
     {
-        parentEdge[v]->addResidualFlowTo(v, bottleneck);
+        G->push(parentArc[v], bottleneck);
     }
 
     flo += bottleneck;
 }
 
-int FordFulkerson::flow()
+template<class Index, class Capacity>
+long long FordFulkerson<Index, Capacity>::flow()
 {
     return flo;
 }
 
-bool FordFulkerson::inCut(int v)
+template<class Index, class Capacity>
+bool FordFulkerson<Index, Capacity>::inCut(Index v)
 {
     return visited[v];
 }
 
-vector<int> FordFulkerson::getCut()
+template<class Index, class Capacity>
+vector<Index> FordFulkerson<Index, Capacity>::getCut()
 {
-    vector<int> cut;
-    for (int i = 0; i < V; i++)
+    vector<Index> cut;
+    for (Index i = 0; i < V; i++)
     {
         if (inCut(i)) { cut.push_back(i); }
     }
@@ -132,18 +150,38 @@ vector<int> FordFulkerson::getCut()
 }
 
 
+bool parseFlowAlg(const char* name, FLOW_ALG_TYPE& alg)
+{
+    if (!strcmp(name, "ff")) { alg = FLOW_FORD_FULKERSON; }
+    else if (!strcmp(name, "push_relabel")) { alg = FLOW_PUSH_RELABEL; }
+    else if (!strcmp(name, "dinic")) { alg = FLOW_DINIC; }
+    else if (!strcmp(name, "parallel_push_relabel")) { alg = FLOW_PARALLEL_PUSH_RELABEL; }
+    else if (!strcmp(name, "hopcroft_karp")) { alg = FLOW_HOPCROFT_KARP; }
+    else { return false; }
+    return true;
+}
+
+
 inline void displayError(string errorMsg)
 {
     cerr<<"Error - "<<errorMsg<<endl;
-    cerr<<"Usage -\n\t./ff task graphFile [resultsFile]"<<endl<<endl;
+    cerr<<"Usage -\n\t./ff task graphFile [resultsFile] [--alg alg] [--cache] [--order order] [--batch] [--threads n]"<<endl<<endl;
     cerr<<"\ttask - maxflow or bipartite_matching"<<endl;
-    cerr<<"\tgraphFile - file containing information about graph"<<endl;
+    cerr<<"\tgraphFile - file containing information about graph, as text or a binary snapshot"<<endl;
     cerr<<"\tresultsFile - optionally write a result to a file"<<endl;
+    cerr<<"\t--alg alg - algorithm (ff, push_relabel, dinic or parallel_push_relabel, or hopcroft_karp for"
+        " bipartite_matching only, defaults to ff for max_flow and hopcroft_karp for bipartite_matching)"<<endl;
+    cerr<<"\t--cache - reuse graphFile.csr as a binary snapshot of graphFile, writing it on first load"<<endl;
+    cerr<<"\t--order order - relabel the vertices before running the algorithm (none, degree, rcm or gorder)"<<endl;
+    cerr<<"\t--batch - graphFile is a directory or a manifest listing one graph file per line, which are all solved"
+        " in one process, appending a line to resultsFile for each"<<endl;
+    cerr<<"\t--threads n - number of threads solving the graphs of a batch, or running parallel_push_relabel on a"
+        " single graph (defaults to all cores)"<<endl;
     exit(EXIT_FAILURE);
 }
 
 
-inline void writeResults(char* fileName, char* graphName, int V, int E, FordFulkerson* ff, double processingTime)
+inline void writeResults(char* fileName, char* graphName, long long V, long long E, long long flow, double processingTime)
 {
     ofstream resultsFile(fileName, ios_base::app);
 
@@ -151,45 +189,155 @@ inline void writeResults(char* fileName, char* graphName, int V, int E, FordFulk
     resultsFile<<graphName<<" ";
     resultsFile<<V<<" ";
     resultsFile<<E<<" ";
-    resultsFile<<ff->flow()<<" ";
+    resultsFile<<flow<<" ";
     resultsFile<<FIXED_FLOAT(processingTime, 6)<<endl;
     resultsFile.close();
 }
 
 
-void task1(int argc, char** argv)
+void writeGraphSnapshot(const char* fileName, SNAPSHOT_KIND kind, const vector<long long>& header, int noRows,
+    const vector<int>& rows, const vector<int>& cols, int base, const vector<long long>* capacities)
 {
+    vector<int> offsets(noRows + 1, 0), targets(rows.size());
+    vector<long long> values(capacities ? rows.size() : 0);
+    for (int x : rows) { offsets[x - base + 1]++; }
+    for (int i = 0; i < noRows; i++) { offsets[i + 1] += offsets[i]; }
 
-    ifstream graphFile(argv[2]);
-    if (!graphFile.is_open()) { displayError("Cannot open graph file."); }
+    vector<int> position(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        int j = position[rows[i] - base]++;
+        targets[j] = cols[i] - base;
+        if (capacities) { values[j] = (*capacities)[i]; }
+    }
 
-    string line;
-    getline(graphFile, line);
-    stringstream ss(line);
+    bool written = capacities
+        ? GraphSnapshot::write(fileName, kind, header, noRows, offsets.data(), targets.data(), values.size(), values.data())
+        : GraphSnapshot::write<int>(fileName, kind, header, noRows, offsets.data(), targets.data(), 0, nullptr);
+    if (!written)
+    {
+        cerr<<"Warning - Cannot write graph snapshot."<<endl;
+    }
+}
 
-    int V, E;
-    ss>>V>>E;
 
-    FlowGraph graph(V);
-    while (getline(graphFile, line))
+bool loadFlowInput(const char* fileName, SNAPSHOT_KIND kind, bool cache, FlowInput& input, string& errorMsg)
+{
+    string snapshotFile = findSnapshot(fileName, cache);
+    input.fromSnapshot = !snapshotFile.empty();
+    if (input.fromSnapshot)
     {
-        int x, y, cap;
-        stringstream ss(line);
+        if (!input.snapshot.open(snapshotFile.c_str(), kind)) { errorMsg = "Invalid graph snapshot."; return false; }
+        input.header = input.snapshot.header();
+        return true;
+    }
+
+    bool bipartite = kind == SNAPSHOT_BIPARTITE;
+    if (!loadEdgeList(fileName, bipartite ? 3 : 2, 2, input.edges, 0, !bipartite)) { errorMsg = "Cannot open graph file."; return false; }
+    input.header = input.edges.header;
 
-        ss>>x>>y>>cap;
-        graph.addEdge(x, y, cap);
+    if (cache)
+    {
+        writeGraphSnapshot(snapshotPath(fileName).c_str(), kind, input.header, input.header[0],
+            input.edges.columns[0], input.edges.columns[1], bipartite ? 1 : 0, bipartite ? nullptr : &input.edges.weights);
     }
-    graphFile.close();
+    return true;
+}
 
-    int s = graph.source();
-    int t = graph.sink();
 
-    clock_t start = clock();
-    FordFulkerson ff(&graph, s, t);
-    clock_t stop = clock();
-    double processingTime = (double)(stop - start)/CLOCKS_PER_SEC;
+void getCapacityRange(FlowInput& input, long long& minCapacity, long long& maxCapacity)
+{
+    const long long* first = input.fromSnapshot ? input.snapshot.weights() : input.edges.weights.data();
+    const long long* last = first + (input.fromSnapshot ? input.snapshot.noValues() : input.edges.weights.size());
+    minCapacity = first == last ? 0 : *min_element(first, last);
+    maxCapacity = first == last ? 0 : *max_element(first, last);
+}
+
 
-    vector<int> cut = ff.getCut();
+template<class Index, class Capacity>
+FlowGraph<Index, Capacity>* buildMaxFlowGraph(FlowInput& input, ORDER_TYPE order, vector<int>& newId, double& orderingTime)
+{
+    GraphSnapshot& snapshot = input.snapshot;
+    const EdgeList& edges = input.edges;
+    int V = input.header[0];
+
+    newId.clear();
+    orderingTime = 0;
+    if (order != ORDER_NONE)
+    {
+        double orderStart = wallTime();
+        vector<int> offsets, targets;
+        if (!input.fromSnapshot) { buildEdgeCSR(V, edges.columns[0], edges.columns[1], 0, offsets, targets); }
+        computeVertexOrder(order, V, input.fromSnapshot ? snapshot.offsets() : offsets.data(),
+            input.fromSnapshot ? snapshot.targets() : targets.data(), newId);
+        orderingTime = wallTime() - orderStart;
+    }
+    auto id = [&](int v) -> Index { return newId.empty() ? v : newId[v]; };
+
+    FlowGraph<Index, Capacity>* graph = new FlowGraph<Index, Capacity>(V);
+    if (input.fromSnapshot)
+    {
+        for (int v = 0; v < snapshot.noRows(); v++)
+        {
+            for (int i = snapshot.offsets()[v]; i < snapshot.offsets()[v + 1]; i++)
+            {
+                graph->addEdge(id(v), id(snapshot.targets()[i]), snapshot.weights()[i]);
+            }
+        }
+    }
+    for (int i = 0; i < edges.noEdges(); i++)
+    {
+        graph->addEdge(id(edges.columns[0][i]), id(edges.columns[1][i]), edges.weights[i]);
+    }
+    graph->buildArcs();
+    return graph;
+}
+
+
+/**
+ * \brief Runs Task 1 on a loaded graph with the given solver, with the flow network
+ * instantiated with the given index and capacity types.
+ *
+ * @param argc - number of command line args, excluding options
+ * @param argv - command line args passed while executing, excluding options
+ * @param input - loaded flow network
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ * @param solver - solver run on the flow network
+ */
+template<class Solver, class Index, class Capacity>
+static void solveMaxFlow(int argc, char** argv, FlowInput& input, ORDER_TYPE order, const FlowSolver<Solver>& solver)
+{
+    long long V = input.header[0], E = input.header[1];
+
+    vector<int> newId, oldId;
+    double orderingTime;
+    unique_ptr<FlowGraph<Index, Capacity> > graphStorage(buildMaxFlowGraph<Index, Capacity>(input, order, newId, orderingTime));
+    FlowGraph<Index, Capacity>& graph = *graphStorage;
+    if (!newId.empty())
+    {
+        oldId.resize(V);
+        for (int v = 0; v < V; v++) { oldId[newId[v]] = v; }
+    }
+
+    Index s = graph.source(newId);
+    Index t = graph.sink(newId);
+
+    double start = wallTime();
+    Solver ff = solver.run(&graph, s, t);
+    double stop = wallTime();
+    double processingTime = stop - start;
+
+    vector<Index> cut = ff.getCut();
+    if (!newId.empty())
+    {
+        cut.clear();
+        for (int v = 0; v < V; v++)
+        {
+            if (ff.inCut(newId[v])) { cut.push_back(v); }
+        }
+        s = oldId[s];
+        t = oldId[t];
+    }
 
     cout<<"Graph Info:"<<endl;
     cout<<"\tVertices - "<<V<<", Edges - "<<E<<endl<<endl;
@@ -198,96 +346,471 @@ void task1(int argc, char** argv)
     cout<<"\tMax Flow Value - "<<ff.flow()<<endl<<endl;
     cout<<"\tNo. of vertices in min cut - "<<cut.size()<<endl;
     cout<<"\tVertices in min cut - "<<endl<<"\t\t";
-    for (int v : cut)
+    for (Index v : cut)
     {
         cout<<v<<" ";
     }
     cout<<endl<<endl;
+    if (order != ORDER_NONE) { cout<<"\tOrdering Time - "<<FIXED_FLOAT(orderingTime, 6)<<" seconds"<<endl; }
 	cout<<"\tTime Taken - "<<FIXED_FLOAT(processingTime, 6)<<" seconds"<<endl;
 
-    if(argc == 4) { writeResults(argv[3], argv[2], V, E, &ff,  processingTime); }
+    if(argc == 4) { writeResults(argv[3], argv[2], V, E, ff.flow(),  processingTime); }
+    PERF_REPORT(argc == 4 ? argv[3] : nullptr, argv[2]);
 }
 
 
-void task3(int argc, char** argv)
+void task1(int argc, char** argv, bool cache, ORDER_TYPE order, FLOW_ALG_TYPE alg, int noThreads)
 {
-    ifstream graphFile(argv[2]);
-    if (!graphFile.is_open()) { displayError("Cannot open graph file."); }
+    FlowInput input;
+    string errorMsg;
+    if (!loadFlowInput(argv[2], SNAPSHOT_FLOW, cache, input, errorMsg)) { displayError(errorMsg); }
 
-    string line;
-    getline(graphFile, line);
-    stringstream ss(line);
+    long long minCapacity, maxCapacity;
+    getCapacityRange(input, minCapacity, maxCapacity);
+    dispatchFlowTypes(minCapacity, maxCapacity, [&](auto types)
+    {
+        typedef typename decltype(types)::Index Index;
+        typedef typename decltype(types)::Capacity Capacity;
+        dispatchFlowAlg<Index, Capacity>(alg, noThreads, [&](auto solver)
+        {
+            solveMaxFlow<typename decltype(solver)::Type, Index, Capacity>(argc, argv, input, order, solver);
+        });
+    });
+}
 
-    int E, n1, n2;
-    ss>>n1>>n2>>E;
 
+/**
+ * \brief Lists the edges of a loaded Task 3 graph, from the left vertex to the right vertex,
+ * both sides numbered from 0.
+ */
+static void getBipartiteEdges(FlowInput& input, vector<int>& rows, vector<int>& cols)
+{
+    GraphSnapshot& snapshot = input.snapshot;
+    const EdgeList& edges = input.edges;
+    if (input.fromSnapshot)
+    {
+        for (int x = 0; x < snapshot.noRows(); x++)
+        {
+            for (int i = snapshot.offsets()[x]; i < snapshot.offsets()[x + 1]; i++)
+            {
+                rows.push_back(x);
+                cols.push_back(snapshot.targets()[i]);
+            }
+        }
+    }
+    for (int i = 0; i < edges.noEdges(); i++)
+    {
+        rows.push_back(edges.columns[0][i] - 1);
+        cols.push_back(edges.columns[1][i] - 1);
+    }
+}
+
+
+/**
+ * \brief Computes the order of the n1 + n2 vertices of a loaded Task 3 graph, the right
+ * vertices numbered from n1.
+ */
+static void computeBipartiteOrder(FlowInput& input, ORDER_TYPE order, vector<int>& newId)
+{
+    int n1 = input.header[0], n = n1 + input.header[1];
+    vector<int> rows, cols, offsets, targets;
+    getBipartiteEdges(input, rows, cols);
+    for (int& y : cols) { y += n1; }
+    buildEdgeCSR(n, rows, cols, 0, offsets, targets);
+    computeVertexOrder(order, n, offsets.data(), targets.data(), newId);
+}
+
+
+template<class Index, class Capacity>
+FlowGraph<Index, Capacity>* buildMatchingGraph(FlowInput& input, ORDER_TYPE order, vector<int>& newId, double& orderingTime)
+{
+    GraphSnapshot& snapshot = input.snapshot;
+    const EdgeList& edges = input.edges;
+    int n1 = input.header[0], n2 = input.header[1];
     int n = n1 + n2, V = n + 2, s = n, t = n + 1;
 
-    FlowGraph graph(V);
-    while (getline(graphFile, line))
+    /*
+     * Only the n vertices of the two sides are relabelled, the source and the sink keep their ids.
+     */
+    newId.clear();
+    orderingTime = 0;
+    if (order != ORDER_NONE)
     {
-        int x, y;
-        stringstream ss(line);
+        double orderStart = wallTime();
+        computeBipartiteOrder(input, order, newId);
+        orderingTime = wallTime() - orderStart;
+    }
+    auto id = [&](int v) -> Index { return newId.empty() ? v : newId[v]; };
 
-        ss>>x>>y;
-        x = x - 1;
-        y = y - 1 + n1;
-        graph.addEdge(x, y, 1);
+    FlowGraph<Index, Capacity>* graph = new FlowGraph<Index, Capacity>(V);
+    if (input.fromSnapshot)
+    {
+        for (int x = 0; x < snapshot.noRows(); x++)
+        {
+            for (int i = snapshot.offsets()[x]; i < snapshot.offsets()[x + 1]; i++)
+            {
+                graph->addEdge(id(x), id(snapshot.targets()[i] + n1), 1);
+            }
+        }
+    }
+    for (int i = 0; i < edges.noEdges(); i++)
+    {
+        int x = edges.columns[0][i] - 1;
+        int y = edges.columns[1][i] - 1 + n1;
+        graph->addEdge(id(x), id(y), 1);
     }
-    graphFile.close();
 
     for (int v = 0; v < n1; v++)
     {
-        graph.addEdge(s, v, 1);
+        graph->addEdge(s, id(v), 1);
     }
 
     for (int v = n1; v < n; v++)
     {
-        graph.addEdge(v, t, 1);
+        graph->addEdge(id(v), t, 1);
     }
+    graph->buildArcs();
+    return graph;
+}
 
-    clock_t start = clock();
-    FordFulkerson ff(&graph, s, t);
-    clock_t stop = clock();
-    double processingTime = (double)(stop - start)/CLOCKS_PER_SEC;
+
+/**
+ * \brief Runs Task 3 on a loaded graph with the given solver, with the flow network
+ * instantiated with the given index and capacity types.
+ *
+ * @param argc - number of command line args, excluding options
+ * @param argv - command line args passed while executing, excluding options
+ * @param input - loaded bipartite graph
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ * @param solver - solver run on the flow network
+ */
+template<class Solver, class Index, class Capacity>
+static void solveMatching(int argc, char** argv, FlowInput& input, ORDER_TYPE order, const FlowSolver<Solver>& solver)
+{
+    typedef typename FlowGraph<Index, Capacity>::Arc Arc;
+    int n1 = input.header[0], n2 = input.header[1];
+    long long E = input.header[2];
+    int n = n1 + n2;
+    Index s = n, t = n + 1;
+
+    vector<int> newId, oldId;
+    double orderingTime;
+    unique_ptr<FlowGraph<Index, Capacity> > graphStorage(buildMatchingGraph<Index, Capacity>(input, order, newId, orderingTime));
+    FlowGraph<Index, Capacity>& graph = *graphStorage;
+    if (!newId.empty())
+    {
+        oldId.resize(n);
+        for (int v = 0; v < n; v++) { oldId[newId[v]] = v; }
+    }
+    auto originalId = [&](Index v) -> long long { return oldId.empty() ? v : oldId[v]; };
+
+    double start = wallTime();
+    Solver ff = solver.run(&graph, s, t);
+    double stop = wallTime();
+    double processingTime = stop - start;
 
     cout<<"Graph Info:"<<endl;
     cout<<"\tVertices - "<<n<<", Edges - "<<E<<endl<<endl;
     cout<<"Bipartite Matching Solution - "<<endl;
     cout<<"\tMaximum Matching Size - "<<ff.flow()<<endl;
     cout<<"\tEdges in the matching - "<<endl;
-    for (FlowEdge* e : graph.adj(s))
+    for (Arc a = graph.firstArc(s); a < graph.endArc(s); a++)
     {
-        if (!e->flow()) { ; }
-
-        int v = e->to();
-        for (FlowEdge* ev : graph.adj(v))
+        if (!graph.flow(a)) { ; }
+
+        /*
+         * Every arc leaving a vertex of the first set is the forward arc of an edge to the
+         * second set, but for the reverse arc back to the source.
+         */
+        Index v = graph.head(a);
+        for (Arc b = graph.firstArc(v); b < graph.endArc(v); b++)
         {
-            int w = ev->other(v);
-            if (w == s || !ev->flow()) { continue; }
-            cout<<"\t\t("<<v + 1<<", "<<w + 1 - n1<<")"<<endl;
+            Index w = graph.head(b);
+            if (w == s || !graph.flow(b)) { continue; }
+            cout<<"\t\t("<<originalId(v) + 1<<", "<<originalId(w) + 1 - n1<<")"<<endl;
             break;
         }
     }
     cout<<endl;
+    if (order != ORDER_NONE) { cout<<"\tOrdering Time - "<<FIXED_FLOAT(orderingTime, 6)<<" seconds"<<endl; }
 	cout<<"\tTime Taken - "<<FIXED_FLOAT(processingTime, 6)<<" seconds"<<endl;
 
-    if(argc == 4) { writeResults(argv[3], argv[2], n, E, &ff,  processingTime); }
+    if(argc == 4) { writeResults(argv[3], argv[2], n, E, ff.flow(),  processingTime); }
+    PERF_REPORT(argc == 4 ? argv[3] : nullptr, argv[2]);
+}
+
+
+void buildBipartiteCSR(FlowInput& input, ORDER_TYPE order, vector<int>& offsets, vector<int>& targets,
+    vector<int>& newId, double& orderingTime)
+{
+    int n1 = input.header[0], n2 = input.header[1];
+
+    /*
+     * The order of all the vertices is split into an order of either side.
+     */
+    newId.clear();
+    orderingTime = 0;
+    if (order != ORDER_NONE)
+    {
+        double orderStart = wallTime();
+        vector<int> jointId;
+        computeBipartiteOrder(input, order, jointId);
+
+        vector<int> byJointId(n1 + n2);
+        for (int v = 0; v < n1 + n2; v++) { byJointId[jointId[v]] = v; }
+        newId.resize(n1 + n2);
+        int noLeft = 0, noRight = 0;
+        for (int v : byJointId) { newId[v] = v < n1 ? noLeft++ : noRight++; }
+        orderingTime = wallTime() - orderStart;
+    }
+
+    vector<int> rows, cols;
+    getBipartiteEdges(input, rows, cols);
+    if (!newId.empty())
+    {
+        for (int& x : rows) { x = newId[x]; }
+        for (int& y : cols) { y = newId[y + n1]; }
+    }
+    buildEdgeCSR(n1, rows, cols, 0, offsets, targets);
+}
+
+
+/**
+ * \brief Runs Task 3 on a loaded graph with HopcroftKarp, printing the matching as
+ * solveMatching does.
+ *
+ * @param argc - number of command line args, excluding options
+ * @param argv - command line args passed while executing, excluding options
+ * @param input - loaded bipartite graph
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ */
+static void solveHopcroftKarp(int argc, char** argv, FlowInput& input, ORDER_TYPE order)
+{
+    int n1 = input.header[0], n2 = input.header[1];
+    long long E = input.header[2];
+    int n = n1 + n2;
+
+    vector<int> offsets, targets, newId, oldRight;
+    double orderingTime;
+    buildBipartiteCSR(input, order, offsets, targets, newId, orderingTime);
+    if (!newId.empty())
+    {
+        oldRight.resize(n2);
+        for (int y = 0; y < n2; y++) { oldRight[newId[y + n1]] = y; }
+    }
+
+    double start = wallTime();
+    HopcroftKarp hk(n1, n2, offsets.data(), targets.data());
+    double stop = wallTime();
+    double processingTime = stop - start;
+
+    cout<<"Graph Info:"<<endl;
+    cout<<"\tVertices - "<<n<<", Edges - "<<E<<endl<<endl;
+    cout<<"Bipartite Matching Solution - "<<endl;
+    cout<<"\tMaximum Matching Size - "<<hk.size()<<endl;
+    cout<<"\tEdges in the matching - "<<endl;
+    for (int x = 0; x < n1; x++)
+    {
+        int y = hk.mate(newId.empty() ? x : newId[x]);
+        if (y == -1) { continue; }
+        cout<<"\t\t("<<x + 1<<", "<<(oldRight.empty() ? y : oldRight[y]) + 1<<")"<<endl;
+    }
+    cout<<endl;
+    if (order != ORDER_NONE) { cout<<"\tOrdering Time - "<<FIXED_FLOAT(orderingTime, 6)<<" seconds"<<endl; }
+	cout<<"\tTime Taken - "<<FIXED_FLOAT(processingTime, 6)<<" seconds"<<endl;
+
+    if(argc == 4) { writeResults(argv[3], argv[2], n, E, hk.size(),  processingTime); }
+    PERF_REPORT(argc == 4 ? argv[3] : nullptr, argv[2]);
+}
+
+
+void task3(int argc, char** argv, bool cache, ORDER_TYPE order, FLOW_ALG_TYPE alg, int noThreads)
+{
+    FlowInput input;
+    string errorMsg;
+    if (!loadFlowInput(argv[2], SNAPSHOT_BIPARTITE, cache, input, errorMsg)) { displayError(errorMsg); }
+
+    if (alg == FLOW_HOPCROFT_KARP)
+    {
+        solveHopcroftKarp(argc, argv, input, order);
+        return;
+    }
+
+    /*
+     * Every edge of the matching network has a unit capacity.
+     */
+    dispatchFlowTypes(1, 1, [&](auto types)
+    {
+        typedef typename decltype(types)::Index Index;
+        typedef typename decltype(types)::Capacity Capacity;
+        dispatchFlowAlg<Index, Capacity>(alg, noThreads, [&](auto solver)
+        {
+            solveMatching<typename decltype(solver)::Type, Index, Capacity>(argc, argv, input, order, solver);
+        });
+    });
+}
+
+
+/*
+ * The instantiations picked by dispatchFlowTypes, also used by the benchmark in bench/.
+ */
+#define INSTANTIATE_FLOW_TYPES(Index, Capacity) \
+    template class FordFulkerson<Index, Capacity>; \
+    template FlowGraph<Index, Capacity>* buildMaxFlowGraph<Index, Capacity>(FlowInput&, ORDER_TYPE, vector<int>&, double&); \
+    template FlowGraph<Index, Capacity>* buildMatchingGraph<Index, Capacity>(FlowInput&, ORDER_TYPE, vector<int>&, double&);
+
+FOR_EACH_FLOW_TYPES(INSTANTIATE_FLOW_TYPES)
+
+/*
+ * The benchmark in bench/ links this file with its own main.
+ */
+#ifndef BENCHMARK
+bool solveBatch(const char* task, char* batchPath, char* resultsFile, int noThreads, bool cache, ORDER_TYPE order,
+    FLOW_ALG_TYPE alg)
+{
+    vector<string> fileNames;
+    if (!listBatchFiles(batchPath, fileNames)) { displayError("Cannot list the graphs of the batch."); }
+
+    bool bipartite = !strcmp(task, "bipartite_matching");
+    auto load = [=](const string& fileName, long long& noEdges) -> BatchTask
+    {
+        shared_ptr<FlowInput> input(new FlowInput());
+        string errorMsg;
+        if (!loadFlowInput(fileName.c_str(), bipartite ? SNAPSHOT_BIPARTITE : SNAPSHOT_FLOW, cache, *input, errorMsg))
+        {
+            reportBatchFailure(fileName, errorMsg);
+            return BatchTask();
+        }
+        noEdges = input->header[bipartite ? 2 : 1];
+
+        long long minCapacity = 1, maxCapacity = 1;
+        if (!bipartite) { getCapacityRange(*input, minCapacity, maxCapacity); }
+
+        if (alg == FLOW_HOPCROFT_KARP)
+        {
+            return [=](int) -> string
+            {
+                vector<int> offsets, targets, newId;
+                double orderingTime;
+                buildBipartiteCSR(*input, order, offsets, targets, newId, orderingTime);
+
+                double start = wallTime();
+                HopcroftKarp hk(input->header[0], input->header[1], offsets.data(), targets.data());
+                double stop = wallTime();
+                double processingTime = stop - start;
+
+                ostringstream line;
+                line<<fileName<<" "<<input->header[0] + input->header[1]<<" "<<input->header[2]<<" "<<hk.size()<<" "
+                    <<FIXED_FLOAT(processingTime, 6);
+                return line.str();
+            };
+        }
+
+        return [=](int) -> string
+        {
+            string result;
+            dispatchFlowTypes(minCapacity, maxCapacity, [&](auto types)
+            {
+                typedef typename decltype(types)::Index Index;
+                typedef typename decltype(types)::Capacity Capacity;
+
+                vector<int> newId;
+                double orderingTime;
+                unique_ptr<FlowGraph<Index, Capacity> > graph(bipartite
+                    ? buildMatchingGraph<Index, Capacity>(*input, order, newId, orderingTime)
+                    : buildMaxFlowGraph<Index, Capacity>(*input, order, newId, orderingTime));
+
+                Index s = graph->noVertices() - 2, t = graph->noVertices() - 1;
+                if (!bipartite)
+                {
+                    try
+                    {
+                        s = graph->source(newId);
+                        t = graph->sink(newId);
+                    }
+                    catch (invalid_argument& e)
+                    {
+                        reportBatchFailure(fileName, e.what());
+                        return;
+                    }
+                }
+
+                /*
+                 * Graphs are solved concurrently, so every graph is solved on one thread.
+                 */
+                long long flow = 0;
+                double start = wallTime();
+                dispatchFlowAlg<Index, Capacity>(alg, 1, [&](auto solver)
+                {
+                    flow = solver.run(graph.get(), s, t).flow();
+                });
+                double stop = wallTime();
+                double processingTime = stop - start;
+
+                ostringstream line;
+                line<<fileName<<" "<<(bipartite ? input->header[0] + input->header[1] : input->header[0])<<" "
+                    <<input->header[bipartite ? 2 : 1]<<" "<<flow<<" "<<FIXED_FLOAT(processingTime, 6);
+                result = line.str();
+            });
+            return result;
+        };
+    };
+
+    return runBatch(fileNames, noThreads, load, resultsFile) == 0;
 }
 
 int main(int argc, char** argv)
 {
-    if (argc < 3 || argc > 4) { displayError("No. of command-line arguments do not match."); }
+    PERF_START();
+
+    vector<char*> args;
+    bool cache = false, batch = false;
+    int noThreads = max((int)thread::hardware_concurrency(), 1);
+    ORDER_TYPE order = ORDER_NONE;
+    FLOW_ALG_TYPE alg = FLOW_FORD_FULKERSON;
+    bool algGiven = false;
+    for (int i = 0; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--cache")) { cache = true; }
+        else if (!strcmp(argv[i], "--alg"))
+        {
+            if (i + 1 == argc || !parseFlowAlg(argv[++i], alg)) { displayError("Unknown maximum flow algorithm."); }
+            algGiven = true;
+        }
+        else if (!strcmp(argv[i], "--batch")) { batch = true; }
+        else if (!strcmp(argv[i], "--threads"))
+        {
+            if (i + 1 == argc || (noThreads = atoi(argv[++i])) < 1) { displayError("Invalid number of threads."); }
+        }
+        else if (!strcmp(argv[i], "--order"))
+        {
+            if (i + 1 == argc || !parseVertexOrder(argv[++i], order)) { displayError("Unknown vertex order."); }
+        }
+        else { args.push_back(argv[i]); }
+    }
+
+    if (args.size() < 3 || args.size() > 4) { displayError("No. of command-line arguments do not match."); }
+
+    bool bipartite = !strcmp("bipartite_matching", args[1]);
+    if (!algGiven && bipartite) { alg = FLOW_HOPCROFT_KARP; }
+    if (alg == FLOW_HOPCROFT_KARP && !bipartite) { displayError("hopcroft_karp only solves bipartite_matching."); }
+
+    if (batch)
+    {
+        if (strcmp("max_flow", args[1]) && strcmp("bipartite_matching", args[1])) { displayError("Incorrect command line argument"); }
+        bool solved = solveBatch(args[1], args[2], args.size() == 4 ? args[3] : nullptr, noThreads, cache, order, alg);
+        return solved ? 0 : EXIT_FAILURE;
+    }
 
-    if (!strcmp("max_flow", argv[1]))
+    if (!strcmp("max_flow", args[1]))
     {
-        task1(argc, argv);
+        task1(args.size(), args.data(), cache, order, alg, noThreads);
         return 0;
     }
 
-    if (!strcmp("bipartite_matching", argv[1]))
+    if (!strcmp("bipartite_matching", args[1]))
     {
-        task3(argc, argv);
+        task3(args.size(), args.data(), cache, order, alg, noThreads);
         return 0;
     }
 
@@ -295,3 +818,4 @@ int main(int argc, char** argv)
 
     return 0;
 }
+#endif
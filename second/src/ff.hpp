@@ -4,6 +4,12 @@
 #include<vector>
 #include<string>
 #include "flow_graph.hpp"
+#include "push_relabel.hpp"
+#include "dinic.hpp"
+#include "parallel_push_relabel.hpp"
+#include "graph_snapshot.hpp"
+#include "vertex_order.hpp"
+#include "edge_loader.hpp"
 
 /** \mainpage
 * The aim of the assignment was to implement FordFulerson algorithm the maximum flow
@@ -19,25 +25,30 @@
  * Class template for the DiGraph abstract data-type.
  *
  * The class is separate and decouples the algorithm from the data-type
- * representing the flow network.
+ * representing the flow network. It is instantiated with the vertex index type and the
+ * capacity type of the flow network, the value of the flow being summed in 64 bits.
  */
+template<class Index, class Capacity>
 class FordFulkerson
 {
     private:
+        typedef FlowGraph<Index, Capacity> Graph;
+        typedef typename Graph::Arc Arc;
+
         /**
          * Number of vertices in the digraph.
          */
-        int V;
+        Index V;
 
         /**
          * The value of the flow in the network at a given state.
          */
-        int flo;
+        long long flo;
 
         /**
          * scaling parameter to speed up the algorithm.
          */
-        int delta;
+        Capacity delta;
 
         /**
          * Boolean vector to mark the vertices visited while finding
@@ -46,10 +57,10 @@ class FordFulkerson
         std::vector<bool> visited;
 
         /**
-         * Vector containing pointers to the parent edges to reconstruct
+         * Vector containing the arcs the vertices were reached by, to reconstruct
          * the augmenting path.
          */
-        std::vector<FlowEdge*> parentEdge;
+        std::vector<Arc> parentArc;
 
         /**
          * \brief Used to initialize delta to the largest power of 2
@@ -57,7 +68,7 @@ class FordFulkerson
          *
          * @param G - pointer to the flow network
          */
-        void initDelta(FlowGraph* G);
+        void initDelta(Graph* G);
 
         /**
          * \brief Runs a modified version of BFS to find the augmenting path
@@ -67,15 +78,16 @@ class FordFulkerson
          * @param s - source vertex
          * @param t - sink/target vertex
          */
-        bool hasAugmentingPath(FlowGraph* G, int s, int t);
+        bool hasAugmentingPath(Graph* G, Index s, Index t);
 
         /**
          * \brief Augments the path found bythe hasAugmentingPath function.
          *
+         * @param G - pointer to the flow network
          * @param s - source vertex
          * @param t - sink/target vertex
          */
-        void augment(int s, int t);
+        void augment(Graph* G, Index s, Index t);
 
     public:
         /**
@@ -88,12 +100,12 @@ class FordFulkerson
          * @param s - source vertex
          * @param t - sink/target vertex
          */
-        FordFulkerson(FlowGraph* G, int s, int t);
+        FordFulkerson(Graph* G, Index s, Index t);
 
         /**
          * \brief Returns the max-flow value calculated by the algorithm.
          */
-        int flow();
+        long long flow();
 
         /**
          * \brief Returns whether the vertex passed is in the given ST Cut
@@ -101,15 +113,100 @@ class FordFulkerson
          *
          * @param v - vertex to be checked
          */
-        bool inCut(int v);
+        bool inCut(Index v);
 
         /**
          * \brief Returns a vector of vertices present in the source set of
          * the min cut.
          */
-        std::vector<int> getCut();
+        std::vector<Index> getCut();
+};
+
+
+/**
+ * \brief Enum representing the algorithm used for finding the maximum flow or matching.
+ *
+ *      FLOW_FORD_FULKERSON - FordFulkerson, with capacity-scaling augmenting paths
+ *      FLOW_PUSH_RELABEL - PushRelabel, with the highest-label rule and global and gap relabelling
+ *      FLOW_DINIC - Dinic, with blocking flows on level graphs and capacity scaling
+ *      FLOW_PARALLEL_PUSH_RELABEL - ParallelPushRelabel, with synchronous rounds on several threads
+ *      FLOW_HOPCROFT_KARP - HopcroftKarp, on the bipartite graph itself (bipartite matching only)
+ *
+ */
+enum FLOW_ALG_TYPE
+{
+    FLOW_FORD_FULKERSON,
+    FLOW_PUSH_RELABEL,
+    FLOW_DINIC,
+    FLOW_PARALLEL_PUSH_RELABEL,
+    FLOW_HOPCROFT_KARP
+};
+
+/**
+ * \brief Parses the name of an algorithm (ff, push_relabel, dinic, parallel_push_relabel or
+ * hopcroft_karp), and returns
+ * whether it is known.
+ *
+ * @param name - name of the algorithm
+ * @param alg - set to the algorithm
+ */
+bool parseFlowAlg(const char* name, FLOW_ALG_TYPE& alg);
+
+/**
+ * \brief Solver class a maximum flow algorithm is run with, and the number of threads it
+ * may use.
+ */
+template<class Solver>
+struct FlowSolver
+{
+    typedef Solver Type;
+
+    int noThreads;
+
+    /**
+     * \brief Runs the solver on a flow network, and returns it.
+     *
+     * @param G - pointer to the flow network
+     * @param s - source vertex
+     * @param t - sink/target vertex
+     */
+    template<class Graph, class Index>
+    Solver run(Graph* G, Index s, Index t) const { return Solver(G, s, t); }
 };
 
+/**
+ * \brief FlowSolver of ParallelPushRelabel, which is also given the number of threads.
+ */
+template<class Index, class Capacity>
+struct FlowSolver<ParallelPushRelabel<Index, Capacity> >
+{
+    typedef ParallelPushRelabel<Index, Capacity> Type;
+
+    int noThreads;
+
+    Type run(FlowGraph<Index, Capacity>* G, Index s, Index t) const { return Type(G, s, t, noThreads); }
+};
+
+/**
+ * \brief Calls visit with the FlowSolver of an algorithm, for the given index and capacity types.
+ * Every solver is run by FlowSolver::run from the flow network, the source and the sink, and
+ * provides flow(), inCut() and getCut(). FLOW_HOPCROFT_KARP has no flow network, and is never passed.
+ *
+ * @param alg - maximum flow algorithm
+ * @param noThreads - number of threads of the parallel algorithms
+ * @param visit - generic callable taking a FlowSolver
+ */
+template<class Index, class Capacity, class Visit>
+void dispatchFlowAlg(FLOW_ALG_TYPE alg, int noThreads, Visit visit)
+{
+    switch (alg)
+    {
+        case FLOW_PUSH_RELABEL: visit(FlowSolver<PushRelabel<Index, Capacity> >{noThreads}); break;
+        case FLOW_DINIC: visit(FlowSolver<Dinic<Index, Capacity> >{noThreads}); break;
+        case FLOW_PARALLEL_PUSH_RELABEL: visit(FlowSolver<ParallelPushRelabel<Index, Capacity> >{noThreads}); break;
+        default: visit(FlowSolver<FordFulkerson<Index, Capacity> >{noThreads});
+    }
+}
 
 /**
  * \brief Function for displaying any errors caused during execution.
@@ -122,28 +219,151 @@ class FordFulkerson
 inline void displayError(std::string errorMsg);
 
 /**
- * \brief Function for running Task 1 (Finding MaxFlow-MinCut).
+ * \brief Writes the edges of a flow network or a bipartite graph as a binary CSR snapshot.
  *
- * @param argv - command line args passed while executing
+ * @param fileName - path of the snapshot
+ * @param kind - kind of graph stored
+ * @param header - numbers on the header line of the text graph file
+ * @param noRows - number of rows of the CSR
+ * @param rows - row of every edge, starting at base
+ * @param cols - column of every edge, starting at base
+ * @param base - index of the first row and column in the text graph file
+ * @param capacities - capacity of every edge, or nullptr
  */
-void task1(char** argv);
+void writeGraphSnapshot(const char* fileName, SNAPSHOT_KIND kind, const std::vector<long long>& header, int noRows,
+    const std::vector<int>& rows, const std::vector<int>& cols, int base, const std::vector<long long>* capacities);
 
 /**
- * \brief Runs a dfs algorithm partitioning the vertices
- * into two sets of the bipartite graph.
+ * \brief A graph file loaded for building a flow network, either parsed from text or
+ * memory-mapped from a binary snapshot.
+ */
+struct FlowInput
+{
+    /**
+     * Snapshot the graph was mapped from, if fromSnapshot is set.
+     */
+    GraphSnapshot snapshot;
+
+    /**
+     * Edges parsed from the text file, if fromSnapshot is not set.
+     */
+    EdgeList edges;
+
+    /**
+     * Whether the graph was mapped from a snapshot.
+     */
+    bool fromSnapshot;
+
+    /**
+     * Numbers on the header line of the graph file.
+     */
+    std::vector<long long> header;
+};
+
+/**
+ * \brief Loads a flow network or a bipartite graph, as text or as a binary snapshot,
+ * writing the snapshot of a text file if cache is set. Returns whether it succeeded,
+ * setting errorMsg otherwise.
+ *
+ * @param fileName - path of the graph file
+ * @param kind - SNAPSHOT_FLOW for a flow network, SNAPSHOT_BIPARTITE for a bipartite graph
+ * @param cache - whether a binary snapshot of the graph is used and written
+ * @param input - filled with the loaded graph
+ * @param errorMsg - set to the cause of a failure
+ */
+bool loadFlowInput(const char* fileName, SNAPSHOT_KIND kind, bool cache, FlowInput& input, std::string& errorMsg);
+
+/**
+ * \brief Finds the smallest and the largest capacity of a loaded Task 1 graph, both 0 if
+ * it has no edges.
+ *
+ * @param input - loaded flow network
+ * @param minCapacity - set to the smallest capacity
+ * @param maxCapacity - set to the largest capacity
+ */
+void getCapacityRange(FlowInput& input, long long& minCapacity, long long& maxCapacity);
+
+/**
+ * \brief Builds the flow network of a loaded Task 1 graph, and returns it.
+ *
+ * @param input - loaded flow network
+ * @param order - order in which the vertices are relabelled
+ * @param newId - filled with the new id of every vertex, or cleared if order is ORDER_NONE
+ * @param orderingTime - set to the time spent computing the order
+ */
+template<class Index, class Capacity>
+FlowGraph<Index, Capacity>* buildMaxFlowGraph(FlowInput& input, ORDER_TYPE order, std::vector<int>& newId,
+    double& orderingTime);
+
+/**
+ * \brief Builds the flow network of a loaded Task 3 graph, with a source n1 + n2 joined to
+ * the first set and a sink n1 + n2 + 1 joined from the second, and returns it.
+ *
+ * @param input - loaded bipartite graph
+ * @param order - order in which the n1 + n2 vertices of the two sets are relabelled
+ * @param newId - filled with the new id of every vertex of the two sets, or cleared if order is ORDER_NONE
+ * @param orderingTime - set to the time spent computing the order
+ */
+template<class Index, class Capacity>
+FlowGraph<Index, Capacity>* buildMatchingGraph(FlowInput& input, ORDER_TYPE order, std::vector<int>& newId,
+    double& orderingTime);
+
+/**
+ * \brief Builds the CSR of a loaded Task 3 graph from every vertex of the first set to its
+ * neighbours in the second, both sets numbered from 0, as HopcroftKarp takes it.
+ *
+ * @param input - loaded bipartite graph
+ * @param order - order in which the n1 + n2 vertices of the two sets are relabelled, each set keeping
+ * its own ids
+ * @param offsets - filled with the offsets into targets for every vertex of the first set
+ * @param targets - filled with the neighbours of all the vertices of the first set
+ * @param newId - filled with the new id of every vertex of the two sets, the second from n1, or cleared
+ * if order is ORDER_NONE
+ * @param orderingTime - set to the time spent computing the order
+ */
+void buildBipartiteCSR(FlowInput& input, ORDER_TYPE order, std::vector<int>& offsets, std::vector<int>& targets,
+    std::vector<int>& newId, double& orderingTime);
+
+/**
+ * \brief Solves Task 1 or Task 3 on every graph of a directory or a manifest, as described
+ * for runBatch, appending a results line for every graph to resultsFile.
+ *
+ * Returns whether every graph was solved.
+ *
+ * @param task - max_flow or bipartite_matching
+ * @param batchPath - directory or manifest of graph files
+ * @param resultsFile - file the results lines are appended to, or nullptr
+ * @param noThreads - number of threads
+ * @param cache - whether binary snapshots of the graphs are used and written
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ * @param alg - maximum flow or matching algorithm, parallel_push_relabel running on one thread
+ * per graph
+ */
+bool solveBatch(const char* task, char* batchPath, char* resultsFile, int noThreads, bool cache, ORDER_TYPE order,
+    FLOW_ALG_TYPE alg);
+
+/**
+ * \brief Function for running Task 1 (Finding MaxFlow-MinCut).
  *
- * @param v - vertex from which dfs begins executing
- * @param visited - vector of bools keeping track of visited vertices
- * @param component - vector keeping track of bipartite set
- * @param G - the graph on which we are running thte dfs
+ * @param argc - number of command line args, excluding options
+ * @param argv - command line args passed while executing, excluding options
+ * @param cache - whether a binary snapshot of the graph is used and written
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ * @param alg - maximum flow algorithm
+ * @param noThreads - number of threads of the parallel algorithms
  */
-void dfsMarkBipartiteSet(int v, std::vector<bool>& visited, std::vector<bool>& component, FlowGraph* G);
+void task1(int argc, char** argv, bool cache, ORDER_TYPE order, FLOW_ALG_TYPE alg, int noThreads);
 
 /**
  * \brief Function for running Task 3 (Finding Maximum Bipartite Matching).
  *
- * @param argv - command line args passed while executing
+ * @param argc - number of command line args, excluding options
+ * @param argv - command line args passed while executing, excluding options
+ * @param cache - whether a binary snapshot of the graph is used and written
+ * @param order - order in which the vertices are relabelled before running the algorithm
+ * @param alg - maximum flow or matching algorithm
+ * @param noThreads - number of threads of the parallel algorithms
  */
-void task3(char** argv);
+void task3(int argc, char** argv, bool cache, ORDER_TYPE order, FLOW_ALG_TYPE alg, int noThreads);
 
 #endif
@@ -1,101 +1,114 @@
 #include<vector>
 #include<stdexcept>
-#include<cmath>
+#include<cstdint>
 
 #include "flow_graph.hpp"
 
 using namespace std;
 
 
-FlowEdge::FlowEdge(int v, int w, int cap)
+template<class Index, class Capacity>
+FlowGraph<Index, Capacity>::FlowGraph(Index V) : indeg(V, 0), outdeg(V, 0)
 {
-    this->v = v;
-    this->w = w;
-    this->cap = cap;
-    this->flo = 0;
-}
-
-int FlowEdge::from()
-{
-    return v;
-}
-
-int FlowEdge::to()
-{
-    return w;
-}
-
-int FlowEdge::capacity()
-{
-    return cap;
+    this->V = V;
+    built = false;
 }
 
-int FlowEdge::flow()
+template<class Index, class Capacity>
+Index FlowGraph<Index, Capacity>::noVertices()
 {
-    return flo;
+    return V;
 }
 
-int FlowEdge::other(int vertex)
+template<class Index, class Capacity>
+typename FlowGraph<Index, Capacity>::Arc FlowGraph<Index, Capacity>::noArcs()
 {
-    if (vertex == v) { return w; }
-    else if (vertex == w) { return v; }
-    else { throw invalid_argument("Not a valid edge end-point."); }
+    return heads.size();
 }
 
-int FlowEdge::residualCapacityTo(int vertex)
+template<class Index, class Capacity>
+void FlowGraph<Index, Capacity>::addEdge(Index v, Index w, Capacity cap)
 {
-    if (vertex == v) { return flo; }
-    else if (vertex == w) { return cap - flo; }
-    else { throw invalid_argument("Not a valid edge end-point."); }
-}
+    if (built) { throw logic_error("Edges cannot be added once the arcs are built."); }
 
-void FlowEdge::addResidualFlowTo(int vertex, int delta)
-{
-    if (vertex == v) { flo -= delta; }
-    else if (vertex == w) { flo += delta; }
-    else { throw invalid_argument("Not a valid edge end-point."); }
-}
-
-
-FlowGraph::FlowGraph(int V) : adjacent(V), indeg(V, 0), outdeg(V, 0)
-{
-    this->V = V;
+    edgeFrom.push_back(v);
+    edgeTo.push_back(w);
+    edgeCapacity.push_back(cap);
+    outdeg[v]++;
+    indeg[w]++;
 }
 
-int FlowGraph::noVertices()
+template<class Index, class Capacity>
+void FlowGraph<Index, Capacity>::buildArcs()
 {
-    return V;
-}
+    if (built) { return; }
+    built = true;
 
-void FlowGraph::addEdge(int v, int w, int cap)
-{
-    FlowEdge* e = new FlowEdge(v, w, cap);
-    outdeg[v]++;
-    indeg[w]++;
+    offsets.assign(V + 1, 0);
+    for (size_t i = 0; i < edgeFrom.size(); i++)
+    {
+        offsets[edgeFrom[i] + 1]++;
+        offsets[edgeTo[i] + 1]++;
+    }
+    for (Index v = 0; v < V; v++)
+    {
+        offsets[v + 1] += offsets[v];
+    }
 
-    adjacent[v].push_back(e);
-    adjacent[w].push_back(e);
-}
+    /*
+     * The arcs of every vertex are filled in the order of their edges, the forward arc of a
+     * self-loop coming just before its reverse arc.
+     */
+    Arc noArcs = offsets[V];
+    heads.resize(noArcs);
+    residuals.resize(noArcs);
+    reverses.resize(noArcs);
+    vector<Arc> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < edgeFrom.size(); i++)
+    {
+        Index v = edgeFrom[i], w = edgeTo[i];
+        Arc forward = next[v]++;
+        Arc backward = next[w]++;
+        heads[forward] = w;
+        residuals[forward] = edgeCapacity[i];
+        reverses[forward] = backward;
+        heads[backward] = v;
+        residuals[backward] = 0;
+        reverses[backward] = forward;
+    }
 
-vector<FlowEdge*>& FlowGraph::adj(int v)
-{
-    return adjacent[v];
+    vector<Index>().swap(edgeFrom);
+    vector<Index>().swap(edgeTo);
+    vector<Capacity>().swap(edgeCapacity);
 }
 
-int FlowGraph::source()
+template<class Index, class Capacity>
+Index FlowGraph<Index, Capacity>::source(const vector<int>& vertexOrder)
 {
-    for (int i = 0; i < V; i++)
+    for (Index i = 0; i < V; i++)
     {
-        if (!indeg[i]) { return i; }
+        Index v = vertexOrder.empty() ? i : vertexOrder[i];
+        if (!indeg[v]) { return v; }
     }
     throw invalid_argument("No source found");
 }
 
-int FlowGraph::sink()
+template<class Index, class Capacity>
+Index FlowGraph<Index, Capacity>::sink(const vector<int>& vertexOrder)
 {
-    for (int i = 0; i < V; i++)
+    for (Index i = 0; i < V; i++)
     {
-        if (!outdeg[i]) { return i; }
+        Index v = vertexOrder.empty() ? i : vertexOrder[i];
+        if (!outdeg[v]) { return v; }
     }
     throw invalid_argument("No sink found");
 }
+
+
+/*
+ * The instantiations picked by dispatchFlowTypes.
+ */
+#define INSTANTIATE_FLOW_GRAPH(Index, Capacity) \
+    template class FlowGraph<Index, Capacity>;
+
+FOR_EACH_FLOW_TYPES(INSTANTIATE_FLOW_GRAPH)
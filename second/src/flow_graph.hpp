@@ -2,164 +2,227 @@
 #define flow_graph_hpp
 
 #include <vector>
+#include <cstdint>
 
 /**
- * Class template for an edge in a flow network.
+ * Class template for the flow network.
+ *
+ * Index is the type of the vertex ids and of the arc ids, and Capacity the type of the edge
+ * capacities.
  *
+ * Edges are added one at a time, and then laid out by buildArcs as the residual network:
+ * every edge v-w becomes a forward arc v->w with its capacity as residual capacity, and a
+ * reverse arc w->v with none, each knowing the other. The arcs leaving every vertex are
+ * contiguous, in the order their edges were added, and every field of the arcs is a separate
+ * array, so the solvers scan the heads and residual capacities of a vertex without touching
+ * anything else, and push flow along an arc by updating it and its reverse.
  */
-class FlowEdge
+template<class Index, class Capacity>
+class FlowGraph
 {
+    public:
+        typedef Index Arc;
+
     private:
         /**
-         * Source vertex of the edge.
-         *
+         * Number of vertices in the digraph.
          */
-        int v;
+        Index V;
 
         /**
-         * Destination vertex of the edge.
-         *
+         * Edges added and not yet laid out as arcs, by source, destination and capacity.
          */
-        int w;
+        std::vector<Index> edgeFrom, edgeTo;
+        std::vector<Capacity> edgeCapacity;
 
         /**
-         *  Capacity of the edge.
-         *
+         * Whether the edges have been laid out as arcs.
          */
-        int cap;
+        bool built;
 
         /**
-         *  Current flow through the edge.
-         *
+         * First arc of every vertex, with a sentinel entry at the end.
          */
-        int flo;
+        std::vector<Arc> offsets;
 
-    public:
         /**
-         * \brief Constructor used for FordFulkerson object.
-         *
-         *
-         * @param v - source vertex of the edge.
-         * @param w - destination vertex of the edge.
-         * @param cap - capacity of the edge.
+         * Head vertex, residual capacity and paired arc of every arc.
          */
-        FlowEdge(int v, int w, int cap);
+        std::vector<Index> heads;
+        std::vector<Capacity> residuals;
+        std::vector<Arc> reverses;
 
         /**
-         * \brief Returns the source vertex of the edge
+         * Stores the indegree of each vertex.
          */
-        int from();
+        std::vector<Index> indeg;
 
         /**
-         * \brief Returns the destination vertex of the edge
+         * Stores the outdegree of each vertex.
          */
-        int to();
+        std::vector<Index> outdeg;
 
+    public:
         /**
-         * \brief Returns the capacity of the edge
+         * \brief Creates the FlowGraph object.
+         *
+         * @param V - number of vertices in the flow graph
          */
-        int capacity();
+        FlowGraph(Index V);
+
+        FlowGraph(const FlowGraph&) = delete;
+        FlowGraph& operator=(const FlowGraph&) = delete;
 
-         /**
-         * \brief Returns the current flow through the edge
+        /**
+         * \brief Returns the umber of vertices in the digraph.
          */
-        int flow();
+        Index noVertices();
 
         /**
-         * \brief Returns the other end point of the edge.
-         *
-         * @param vertex - one end point of the edge
+         * \brief Returns the number of arcs, twice the number of edges, once they are built.
          */
-        int other(int vertex);
+        Arc noArcs();
 
         /**
-         * \brief Returns the residual capacity.
+         * \brief Adds a flow edge between vertices with given capacity.
+         *
+         * It adds two directed arcs (forward & backward) when the arcs are built, and cannot
+         * be called afterwards.
          *
-         * @param vertex - vertex used for distinguishing if edge is backward or forward.
+         * @param v - one end point of the edge
+         * @param w - other end point of the edge
+         * @param cap - capacity of the edge
          */
-        int residualCapacityTo(int vertex);
+        void addEdge(Index v, Index w, Capacity cap);
 
         /**
-         * \brief Changes the flow of the edge by using delta.
+         * \brief Lays the edges added out as arcs, if it has not been done yet.
          *
-         * @param vertex - vertex used for distinguishing if edge is backward or forward.
-         * @param delta - amount of change in the flow
+         * The graph builders call it, so that it is not timed with the solvers, and the
+         * solvers call it again before they run.
          */
-        void addResidualFlowTo(int vertex, int delta);
-
-};
+        void buildArcs();
 
-/**
- * Class template for the flow network.
- *
- */
-class FlowGraph
-{
-    private:
-        /**
-         * Number of vertices in the digraph.
+        /*
+         * The accessors of the arcs are defined here, so that the inner loops of the solvers
+         * inline them.
          */
-        int V;
 
         /**
-         * Adjacency list for storing the graph's edges.
+         * \brief Returns the first arc leaving a vertex.
          *
+         * @param v - vertex
          */
-        std::vector<std::vector<FlowEdge*> > adjacent;
-
+        Arc firstArc(Index v) { return offsets[v]; }
 
         /**
-         * Stores the indegree of each vertex.
+         * \brief Returns the arc after the last arc leaving a vertex.
+         *
+         * @param v - vertex
          */
-        std::vector<int> indeg;
+        Arc endArc(Index v) { return offsets[v + 1]; }
 
         /**
-         * Stores the outdegree of each vertex.
+         * \brief Returns the vertex an arc leads to.
+         *
+         * @param a - arc
          */
-        std::vector<int> outdeg;
+        Index head(Arc a) { return heads[a]; }
 
-    public:
         /**
-         * \brief Creates the FlowGraph object.
+         * \brief Returns the residual capacity of an arc.
          *
-         * @param V - number of vertices in the flow graph
+         * @param a - arc
          */
-        FlowGraph(int V);
+        Capacity residual(Arc a) { return residuals[a]; }
 
         /**
-         * \brief Returns the umber of vertices in the digraph.
+         * \brief Returns the arc paired with an arc, leading back to its tail.
+         *
+         * @param a - arc
          */
-        int noVertices();
+        Arc reverse(Arc a) { return reverses[a]; }
 
         /**
-         * \brief Adds a flow edge between vertices with given capacity.
+         * \brief Returns the flow through the edge of a forward arc, the residual capacity
+         * of its reverse arc.
          *
-         * It adds two directed edges (forward & backward).
-         *
-         * @param v - one end point of the edge
-         * @param w - other end point of the edge
-         * @param cap - capacity of the edge
+         * @param a - forward arc
          */
-        void addEdge(int v, int w, int cap);
+        Capacity flow(Arc a) { return residuals[reverses[a]]; }
 
         /**
-         * \brief Returns the adjacencvy list of a vertex
+         * \brief Pushes flow along an arc, moving residual capacity to its reverse arc.
          *
-         * @param v - vertex for which we want the adjacency list
+         * @param a - arc
+         * @param delta - amount of flow, at most the residual capacity of the arc
          */
-        std::vector<FlowEdge*>& adj(int v);
+        void push(Arc a, Capacity delta)
+        {
+            residuals[a] -= delta;
+            residuals[reverses[a]] += delta;
+        }
 
         /**
          * \brief Returns the source vertex of the graph.
          *
+         * @param vertexOrder - new id of every vertex if the vertices were relabelled, in which
+         * case the first source in the original order is returned
          */
-        int source();
+        Index source(const std::vector<int>& vertexOrder = std::vector<int>());
 
         /**
          * \brief Returns the sink vertex of the graph.
          *
+         * @param vertexOrder - new id of every vertex if the vertices were relabelled, in which
+         * case the first sink in the original order is returned
          */
-        int sink();
+        Index sink(const std::vector<int>& vertexOrder = std::vector<int>());
 };
 
+/**
+ * \brief Pair of the vertex index type and the capacity type a flow network is
+ * instantiated with.
+ */
+template<class IndexType, class CapacityType>
+struct FlowTypes
+{
+    typedef IndexType Index;
+    typedef CapacityType Capacity;
+};
+
+/**
+ * Applies a macro to every pair of index and capacity types dispatchFlowTypes picks, for
+ * the explicit instantiations of the flow network and the solvers.
+ *
+ * Vertex and arc ids are always 32-bit: the loaders and snapshots number vertices and edges
+ * with int, so a network has at most INT_MAX vertices and 2 * INT_MAX arcs, which uint32_t
+ * numbers. 64-bit ids are left out until the loaders can number more, as they could never
+ * be picked.
+ */
+#define FOR_EACH_FLOW_TYPES(MACRO) \
+    MACRO(uint32_t, uint8_t) \
+    MACRO(uint32_t, int32_t) \
+    MACRO(uint32_t, int64_t)
+
+/**
+ * \brief Calls visit with the FlowTypes of the narrowest instantiation holding a flow
+ * network: 32-bit vertex and arc ids, and 8-bit, 32-bit or 64-bit capacities, the
+ * narrowest holding every capacity.
+ *
+ * Every instantiation is compiled explicitly for FOR_EACH_FLOW_TYPES, so visit only needs
+ * to be generic over those types.
+ *
+ * @param minCapacity - smallest capacity of an edge
+ * @param maxCapacity - largest capacity of an edge
+ * @param visit - generic callable taking a FlowTypes
+ */
+template<class Visit>
+void dispatchFlowTypes(long long minCapacity, long long maxCapacity, Visit visit)
+{
+    if (minCapacity >= 0 && maxCapacity <= UINT8_MAX) { visit(FlowTypes<uint32_t, uint8_t>()); }
+    else if (minCapacity >= INT32_MIN && maxCapacity <= INT32_MAX) { visit(FlowTypes<uint32_t, int32_t>()); }
+    else { visit(FlowTypes<uint32_t, int64_t>()); }
+}
+
 #endif
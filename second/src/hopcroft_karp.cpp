@@ -0,0 +1,133 @@
+#include<vector>
+#include<algorithm>
+
+#include "hopcroft_karp.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+HopcroftKarp::HopcroftKarp(int noLeft, int noRight, const int* offsets, const int* targets)
+{
+    this->noLeft = noLeft;
+    this->noRight = noRight;
+    matchLeft.assign(noLeft, -1);
+    matchRight.assign(noRight, -1);
+    dist.resize(noLeft);
+    currentArc.resize(noLeft);
+
+    greedyMatching(offsets, targets);
+
+    vector<int> path;
+    for (int length; (length = layer(offsets, targets)) != -1;)
+    {
+        PERF_REGION("hopcroft-karp:augment");
+        for (int x = 0; x < noLeft; x++)
+        {
+            if (matchLeft[x] == -1 && augment(offsets, targets, x, length, path)) { noMatched++; }
+        }
+    }
+}
+
+void HopcroftKarp::greedyMatching(const int* offsets, const int* targets)
+{
+    noMatched = 0;
+    for (int x = 0; x < noLeft; x++)
+    {
+        for (int i = offsets[x]; i < offsets[x + 1]; i++)
+        {
+            int y = targets[i];
+            if (matchRight[y] == -1)
+            {
+                matchLeft[x] = y;
+                matchRight[y] = x;
+                noMatched++;
+                break;
+            }
+        }
+    }
+}
+
+int HopcroftKarp::layer(const int* offsets, const int* targets)
+{
+    PERF_REGION("hopcroft-karp:layer");
+    vector<int> order;
+    for (int x = 0; x < noLeft; x++)
+    {
+        dist[x] = matchLeft[x] == -1 ? 0 : -1;
+        if (!dist[x]) { order.push_back(x); }
+        currentArc[x] = offsets[x];
+    }
+
+    /*
+     * Left vertices as far from the free ones as the first free right vertex are not
+     * expanded, as no shortest augmenting path passes through them.
+     */
+    int length = -1;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        int x = order[i];
+        if (length != -1 && dist[x] >= length) { break; }
+
+        for (int j = offsets[x]; j < offsets[x + 1]; j++)
+        {
+            int next = matchRight[targets[j]];
+            if (next == -1) { length = dist[x] + 1; }
+            else if (dist[next] == -1)
+            {
+                dist[next] = dist[x] + 1;
+                order.push_back(next);
+            }
+        }
+    }
+    return length;
+}
+
+bool HopcroftKarp::augment(const int* offsets, const int* targets, int root, int length, vector<int>& path)
+{
+    path.assign(1, root);
+    while (!path.empty())
+    {
+        int x = path.back();
+        if (currentArc[x] == offsets[x + 1])
+        {
+            /*
+             * No shortest augmenting path passes through x any more.
+             */
+            dist[x] = -1;
+            path.pop_back();
+            if (!path.empty()) { currentArc[path.back()]++; }
+            continue;
+        }
+
+        int y = targets[currentArc[x]];
+        int next = matchRight[y];
+        if (next == -1 && dist[x] + 1 == length)
+        {
+            /*
+             * The current arc of every left vertex on the path leads to the next one.
+             */
+            for (int u : path)
+            {
+                int v = targets[currentArc[u]];
+                matchLeft[u] = v;
+                matchRight[v] = u;
+            }
+            return true;
+        }
+
+        if (next != -1 && dist[next] == dist[x] + 1) { path.push_back(next); }
+        else { currentArc[x]++; }
+    }
+    return false;
+}
+
+int HopcroftKarp::size()
+{
+    return noMatched;
+}
+
+int HopcroftKarp::mate(int x)
+{
+    return matchLeft[x];
+}
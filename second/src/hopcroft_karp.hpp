@@ -0,0 +1,101 @@
+#ifndef hopcroft_karp_hpp
+#define hopcroft_karp_hpp
+
+#include<vector>
+
+/**
+ * Class template for Hopcroft and Karp's maximum bipartite matching algorithm.
+ *
+ * The graph is a CSR from every left vertex to its right neighbours, both sides numbered
+ * from 0, with no source, sink or flow edges. The matching starts greedy. Every phase then
+ * labels the left vertices by a BFS from the free ones over alternating paths, up to the
+ * first free right vertex, and augments along a maximal set of vertex-disjoint shortest
+ * augmenting paths, found by depth-first searches resuming at a current-arc pointer per
+ * left vertex. There are O(sqrt(V)) phases of O(E) each.
+ */
+class HopcroftKarp
+{
+    private:
+        /**
+         * Number of vertices on the left and on the right.
+         */
+        int noLeft, noRight;
+
+        /**
+         * Number of matched pairs.
+         */
+        int noMatched;
+
+        /**
+         * Right vertex matched to every left vertex, and left vertex matched to every
+         * right vertex, -1 if free.
+         */
+        std::vector<int> matchLeft, matchRight;
+
+        /**
+         * Length of the shortest alternating path from a free left vertex to every left
+         * vertex, in matched edges, or -1 if it is not on a shortest augmenting path.
+         */
+        std::vector<int> dist;
+
+        /**
+         * Position in the CSR of the next edge the search leaves a left vertex by.
+         */
+        std::vector<int> currentArc;
+
+        /**
+         * \brief Matches every left vertex to its first free neighbour, if any.
+         *
+         * @param offsets - offsets into targets for every left vertex, with a sentinel entry at the end
+         * @param targets - right neighbours of all the left vertices
+         */
+        void greedyMatching(const int* offsets, const int* targets);
+
+        /**
+         * \brief Labels the left vertices by the alternating BFS from the free ones, and
+         * returns the length of the shortest augmenting paths, -1 if there are none.
+         *
+         * @param offsets - offsets into targets for every left vertex, with a sentinel entry at the end
+         * @param targets - right neighbours of all the left vertices
+         */
+        int layer(const int* offsets, const int* targets);
+
+        /**
+         * \brief Searches for a shortest augmenting path from a free left vertex, and
+         * augments the matching along it, returning whether it found one.
+         *
+         * @param offsets - offsets into targets for every left vertex, with a sentinel entry at the end
+         * @param targets - right neighbours of all the left vertices
+         * @param root - free left vertex
+         * @param length - length of the shortest augmenting paths
+         * @param path - scratch stack of left vertices
+         */
+        bool augment(const int* offsets, const int* targets, int root, int length, std::vector<int>& path);
+
+    public:
+        /**
+         * \brief Constructor used for HopcroftKarp object.
+         *
+         * The constructor also runs the algorithm and finds a maximum matching.
+         *
+         * @param noLeft - number of left vertices
+         * @param noRight - number of right vertices
+         * @param offsets - offsets into targets for every left vertex, with a sentinel entry at the end
+         * @param targets - right neighbours of all the left vertices
+         */
+        HopcroftKarp(int noLeft, int noRight, const int* offsets, const int* targets);
+
+        /**
+         * \brief Returns the size of the maximum matching.
+         */
+        int size();
+
+        /**
+         * \brief Returns the right vertex matched to a left vertex, or -1 if it is free.
+         *
+         * @param x - left vertex
+         */
+        int mate(int x);
+};
+
+#endif
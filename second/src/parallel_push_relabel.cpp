@@ -0,0 +1,282 @@
+#include<vector>
+#include<atomic>
+#include<algorithm>
+#include<cstdint>
+
+#include "parallel_push_relabel.hpp"
+#include "thread_pool.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+/**
+ * Work charged to every relabel and to every vertex, and the fraction of the size of the graph
+ * between two global relabellings, as in PushRelabel.
+ */
+const long long RELABEL_WORK = 12;
+const long long VERTEX_WORK = 6;
+const double GLOBAL_RELABEL_FREQUENCY = 0.5;
+
+/**
+ * Number of active or frontier vertices handed to one task, and of vertices when all of them
+ * are scanned.
+ */
+const int PARALLEL_GRAIN = 256;
+const int VERTEX_GRAIN = 1 << 14;
+
+
+template<class Index, class Capacity>
+ParallelPushRelabel<Index, Capacity>::ParallelPushRelabel(Graph* G, Index s, Index t, int noThreads) :
+    addedExcess(G->noVertices()), height(G->noVertices()), queued(G->noVertices())
+{
+    G->buildArcs();
+    V = G->noVertices();
+    E = G->noArcs() / 2;
+    this->s = s;
+    this->t = t;
+    this->noThreads = noThreads;
+
+    excess.assign(V, 0);
+    newHeight.assign(V, 0);
+    ThreadPool pool(noThreads);
+
+    {
+        PERF_REGION("parallel-push-relabel:preflow");
+        for (Arc a = G->firstArc(s); a < G->endArc(s); a++)
+        {
+            Index w = G->head(a);
+            Capacity residual = G->residual(a);
+            if (w != s && residual > 0)
+            {
+                G->push(a, residual);
+                excess[w] += residual;
+                excess[s] -= residual;
+            }
+        }
+        runPhase(G, pool, t, s);
+    }
+    flo = excess[t];
+
+    {
+        PERF_REGION("parallel-push-relabel:return excess");
+        runPhase(G, pool, s, t);
+    }
+
+    /*
+     * The labels are left as the distances from the source, V for the vertices of the sink side.
+     */
+    search(G, pool, s, V, false);
+}
+
+template<class Index, class Capacity>
+void ParallelPushRelabel<Index, Capacity>::search(Graph* G, ThreadPool& pool, Index root, Index excluded, bool towardsRoot)
+{
+    pool.parallelFor(0, V, VERTEX_GRAIN, [&](int begin, int end)
+    {
+        for (int v = begin; v < end; v++) { height[v].store(V, memory_order_relaxed); }
+    });
+    height[root].store(0, memory_order_relaxed);
+
+    vector<Index> frontier(1, root), next;
+    for (Index level = 1; !frontier.empty(); level++)
+    {
+        vector<vector<Index> > partial((frontier.size() + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN);
+        pool.parallelFor(0, frontier.size(), PARALLEL_GRAIN, [&](int begin, int end)
+        {
+            vector<Index>& local = partial[begin / PARALLEL_GRAIN];
+            for (int i = begin; i < end; i++)
+            {
+                Index w = frontier[i];
+                for (Arc a = G->firstArc(w); a < G->endArc(w); a++)
+                {
+                    /*
+                     * The label is checked first, as the reverse arc is seldom in the cache.
+                     */
+                    Index u = G->head(a);
+                    if (height[u].load(memory_order_relaxed) != V || u == excluded) { continue; }
+                    if (G->residual(towardsRoot ? G->reverse(a) : a) <= 0) { continue; }
+
+                    Index expected = V;
+                    if (height[u].compare_exchange_strong(expected, level, memory_order_relaxed)) { local.push_back(u); }
+                }
+            }
+        });
+
+        next.clear();
+        for (vector<Index>& local : partial)
+        {
+            next.insert(next.end(), local.begin(), local.end());
+        }
+        frontier.swap(next);
+    }
+}
+
+template<class Index, class Capacity>
+void ParallelPushRelabel<Index, Capacity>::globalRelabel(Graph* G, ThreadPool& pool, Index target, Index excluded)
+{
+    PERF_REGION("parallel-push-relabel:global relabel");
+    work = 0;
+    search(G, pool, target, excluded, true);
+
+    vector<vector<Index> > partial((V + VERTEX_GRAIN - 1) / VERTEX_GRAIN);
+    pool.parallelFor(0, V, VERTEX_GRAIN, [&](int begin, int end)
+    {
+        vector<Index>& local = partial[begin / VERTEX_GRAIN];
+        for (int v = begin; v < end; v++)
+        {
+            if ((Index)v != target && excess[v] > 0 && height[v].load(memory_order_relaxed) < V) { local.push_back(v); }
+        }
+    });
+
+    active.clear();
+    for (vector<Index>& local : partial)
+    {
+        active.insert(active.end(), local.begin(), local.end());
+    }
+}
+
+template<class Index, class Capacity>
+void ParallelPushRelabel<Index, Capacity>::runPhase(Graph* G, ThreadPool& pool, Index target, Index excluded)
+{
+    double graphSize = VERTEX_WORK * (double)V + E;
+    globalRelabel(G, pool, target, excluded);
+    while (!active.empty())
+    {
+        int noChunks = (active.size() + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        vector<vector<Index> > reached(noChunks), relabelled(noChunks);
+
+        /*
+         * Every active vertex pushes along the arcs one label down. The vertex at the other end
+         * is lower, so it never pushes back along the same edge in the round, and the pair of
+         * arcs is only updated by this thread.
+         */
+        pool.parallelFor(0, active.size(), PARALLEL_GRAIN, [&](int begin, int end)
+        {
+            vector<Index>& localReached = reached[begin / PARALLEL_GRAIN];
+            for (int i = begin; i < end; i++)
+            {
+                Index v = active[i], h = height[v].load(memory_order_relaxed);
+                long long e = excess[v];
+                for (Arc a = G->firstArc(v); a < G->endArc(v) && e > 0; a++)
+                {
+                    Index w = G->head(a);
+                    if (height[w].load(memory_order_relaxed) + 1 != h) { continue; }
+
+                    Capacity residual = G->residual(a);
+                    if (residual <= 0) { continue; }
+
+                    Capacity delta = (Capacity)min(e, (long long)residual);
+                    G->push(a, delta);
+                    e -= delta;
+                    addedExcess[w].fetch_add(delta, memory_order_relaxed);
+                    if (w != target && !queued[w].load(memory_order_relaxed) && !queued[w].exchange(true, memory_order_relaxed))
+                    {
+                        localReached.push_back(w);
+                    }
+                }
+                excess[v] = e;
+                if (e > 0) { relabelled[begin / PARALLEL_GRAIN].push_back(v); }
+            }
+        });
+
+        /*
+         * The vertices left with excess have no admissible arc, and are lifted above their lowest
+         * residual neighbour, by the labels of the start of the round.
+         */
+        vector<Index> relabel;
+        for (vector<Index>& local : relabelled)
+        {
+            relabel.insert(relabel.end(), local.begin(), local.end());
+        }
+        pool.parallelFor(0, relabel.size(), PARALLEL_GRAIN, [&](int begin, int end)
+        {
+            long long localWork = 0;
+            for (int i = begin; i < end; i++)
+            {
+                Index v = relabel[i], lowest = V;
+                for (Arc a = G->firstArc(v); a < G->endArc(v); a++)
+                {
+                    if (G->residual(a) > 0) { lowest = min(lowest, (Index)(height[G->head(a)].load(memory_order_relaxed) + 1)); }
+                }
+                newHeight[v] = lowest;
+                localWork += RELABEL_WORK + (G->endArc(v) - G->firstArc(v));
+            }
+            work += localWork;
+        });
+
+        /*
+         * The new labels and the excess pushed in the round are applied to every vertex reached
+         * or relabelled, once.
+         */
+        vector<Index> candidates;
+        for (vector<Index>& local : reached)
+        {
+            candidates.insert(candidates.end(), local.begin(), local.end());
+        }
+        for (Index v : relabel)
+        {
+            if (!queued[v].exchange(true, memory_order_relaxed)) { candidates.push_back(v); }
+        }
+
+        vector<vector<Index> > partial((candidates.size() + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN);
+        pool.parallelFor(0, candidates.size(), PARALLEL_GRAIN, [&](int begin, int end)
+        {
+            vector<Index>& local = partial[begin / PARALLEL_GRAIN];
+            for (int i = begin; i < end; i++)
+            {
+                Index v = candidates[i];
+                if (newHeight[v])
+                {
+                    height[v].store(newHeight[v], memory_order_relaxed);
+                    newHeight[v] = 0;
+                }
+                queued[v].store(false, memory_order_relaxed);
+                excess[v] += addedExcess[v].exchange(0, memory_order_relaxed);
+                if (excess[v] > 0 && height[v].load(memory_order_relaxed) < V) { local.push_back(v); }
+            }
+        });
+
+        active.clear();
+        for (vector<Index>& local : partial)
+        {
+            active.insert(active.end(), local.begin(), local.end());
+        }
+
+        if (work * GLOBAL_RELABEL_FREQUENCY > graphSize) { globalRelabel(G, pool, target, excluded); }
+    }
+    excess[target] += addedExcess[target].exchange(0, memory_order_relaxed);
+}
+
+template<class Index, class Capacity>
+long long ParallelPushRelabel<Index, Capacity>::flow()
+{
+    return flo;
+}
+
+template<class Index, class Capacity>
+bool ParallelPushRelabel<Index, Capacity>::inCut(Index v)
+{
+    return height[v].load(memory_order_relaxed) < V;
+}
+
+template<class Index, class Capacity>
+vector<Index> ParallelPushRelabel<Index, Capacity>::getCut()
+{
+    vector<Index> cut;
+    for (Index i = 0; i < V; i++)
+    {
+        if (inCut(i)) { cut.push_back(i); }
+    }
+
+    return cut;
+}
+
+
+/*
+ * The instantiations picked by dispatchFlowTypes.
+ */
+#define INSTANTIATE_PARALLEL_PUSH_RELABEL(Index, Capacity) \
+    template class ParallelPushRelabel<Index, Capacity>;
+
+FOR_EACH_FLOW_TYPES(INSTANTIATE_PARALLEL_PUSH_RELABEL)
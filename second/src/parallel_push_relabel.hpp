@@ -0,0 +1,157 @@
+#ifndef parallel_push_relabel_hpp
+#define parallel_push_relabel_hpp
+
+#include<vector>
+#include<atomic>
+#include "flow_graph.hpp"
+
+class ThreadPool;
+
+/**
+ * Class template for a multi-threaded push-relabel maximum flow algorithm, in the synchronous
+ * style of Baumstark, Blelloch and Shun, with the same interface as FordFulkerson.
+ *
+ * The algorithm runs in rounds over the set of active vertices. In every round, all of them
+ * push their excess in parallel along the arcs admissible under the labels of the start of
+ * the round, and those left with excess are then relabelled in parallel from the same labels.
+ * Two ends of an edge are never both admissible, so every arc is pushed along by a single
+ * thread, and only the excess reaching a vertex is added atomically. The labels are recomputed
+ * by a parallel BFS from the sink once the relabelling work reaches half the size of the
+ * graph. As in PushRelabel, the first phase finds a maximum preflow, and the second returns the
+ * excess of the vertices cut off from the sink to the source in the same way.
+ *
+ * Every round depends only on the state at its start, so the flow found does not depend on
+ * the number of threads or their interleaving.
+ */
+template<class Index, class Capacity>
+class ParallelPushRelabel
+{
+    private:
+        typedef FlowGraph<Index, Capacity> Graph;
+        typedef typename Graph::Arc Arc;
+
+        /**
+         * Number of vertices and edges in the digraph.
+         */
+        Index V;
+        long long E;
+
+        /**
+         * Source and sink vertices.
+         */
+        Index s, t;
+
+        /**
+         * Number of threads.
+         */
+        int noThreads;
+
+        /**
+         * The value of the flow in the network.
+         */
+        long long flo;
+
+        /**
+         * Flow entering every vertex less the flow leaving it, as of the start of the round.
+         */
+        std::vector<long long> excess;
+
+        /**
+         * Flow pushed into every vertex during the round.
+         */
+        std::vector<std::atomic<long long> > addedExcess;
+
+        /**
+         * Label of every vertex, V for the vertices out of the phase.
+         */
+        std::vector<std::atomic<Index> > height;
+
+        /**
+         * Labels computed by the relabelling step of the round.
+         */
+        std::vector<Index> newHeight;
+
+        /**
+         * Whether a vertex is already in the active vertices of the next round.
+         */
+        std::vector<std::atomic<bool> > queued;
+
+        /**
+         * Active vertices of the round.
+         */
+        std::vector<Index> active;
+
+        /**
+         * Relabelling work done since the last global relabelling.
+         */
+        std::atomic<long long> work;
+
+        /**
+         * \brief Labels every vertex by its distance in the residual network, V if it is not
+         * connected, with a level-synchronous parallel BFS.
+         *
+         * @param G - pointer to the flow network
+         * @param pool - threads running the search
+         * @param root - vertex labelled 0
+         * @param excluded - vertex left out of the search, V for none
+         * @param towardsRoot - whether distances are measured to the root rather than from it
+         */
+        void search(Graph* G, ThreadPool& pool, Index root, Index excluded, bool towardsRoot);
+
+        /**
+         * \brief Relabels every vertex by its distance to the target, and makes the vertices
+         * with excess that reach it the active vertices.
+         *
+         * @param G - pointer to the flow network
+         * @param pool - threads running the phase
+         * @param target - vertex the excess is pushed to
+         * @param excluded - vertex left out of the phase
+         */
+        void globalRelabel(Graph* G, ThreadPool& pool, Index target, Index excluded);
+
+        /**
+         * \brief Pushes excess towards the target in rounds until no vertex that can reach
+         * it has any excess.
+         *
+         * @param G - pointer to the flow network
+         * @param pool - threads running the phase
+         * @param target - vertex the excess is pushed to
+         * @param excluded - vertex left out of the phase
+         */
+        void runPhase(Graph* G, ThreadPool& pool, Index target, Index excluded);
+
+    public:
+        /**
+         * \brief Constructor used for ParallelPushRelabel object.
+         *
+         * The constructor also runs the algorithm and finds the maximum flow, and the
+         * minimum cut solutions.
+         *
+         * @param G - pointer to the flow network
+         * @param s - source vertex
+         * @param t - sink/target vertex
+         * @param noThreads - number of threads
+         */
+        ParallelPushRelabel(Graph* G, Index s, Index t, int noThreads);
+
+        /**
+         * \brief Returns the max-flow value calculated by the algorithm.
+         */
+        long long flow();
+
+        /**
+         * \brief Returns whether the vertex passed is in the given ST Cut
+         * (in the source set)
+         *
+         * @param v - vertex to be checked
+         */
+        bool inCut(Index v);
+
+        /**
+         * \brief Returns a vector of vertices present in the source set of
+         * the min cut.
+         */
+        std::vector<Index> getCut();
+};
+
+#endif
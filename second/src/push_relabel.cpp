@@ -0,0 +1,335 @@
+#include<vector>
+#include<queue>
+#include<algorithm>
+#include<limits>
+#include<cstdint>
+
+#include "push_relabel.hpp"
+#include "perf_counters.hpp"
+
+using namespace std;
+
+
+/**
+ * Work charged to every relabel on top of the edges it scans, and to every vertex in the
+ * size of the graph the global relabelling frequency is measured against, as in Cherkassky
+ * and Goldberg's hi_pr.
+ */
+const long long RELABEL_WORK = 12;
+const long long VERTEX_WORK = 6;
+
+/**
+ * Fraction of the size of the graph, in relabelling work, between two global relabellings.
+ */
+const double GLOBAL_RELABEL_FREQUENCY = 0.5;
+
+
+template<class Index, class Capacity>
+PushRelabel<Index, Capacity>::PushRelabel(Graph* G, Index s, Index t)
+{
+    G->buildArcs();
+    V = G->noVertices();
+    E = G->noArcs() / 2;
+    this->s = s;
+    this->t = t;
+
+    excess.assign(V, 0);
+    height.assign(V, V);
+    currentArc.resize(V);
+    active.resize(V);
+    bucketHead.assign(V, V);
+    bucketNext.assign(V, V);
+    bucketPrev.assign(V, V);
+
+    maxPreflow(G);
+    flo = excess[t];
+    returnExcess(G);
+    markCut(G);
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::insertBucket(Index v)
+{
+    Index h = height[v];
+    bucketPrev[v] = V;
+    bucketNext[v] = bucketHead[h];
+    if (bucketHead[h] != V) { bucketPrev[bucketHead[h]] = v; }
+    bucketHead[h] = v;
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::removeBucket(Index v)
+{
+    Index h = height[v];
+    if (bucketPrev[v] != V) { bucketNext[bucketPrev[v]] = bucketNext[v]; }
+    else { bucketHead[h] = bucketNext[v]; }
+    if (bucketNext[v] != V) { bucketPrev[bucketNext[v]] = bucketPrev[v]; }
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::activate(Index v)
+{
+    active[height[v]].push_back(v);
+    maxActive = max(maxActive, height[v]);
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::globalRelabel(Graph* G)
+{
+    PERF_REGION("push-relabel:global relabel");
+    work = 0;
+    fill(height.begin(), height.end(), V);
+    fill(bucketHead.begin(), bucketHead.end(), V);
+    for (vector<Index>& bucket : active) { bucket.clear(); }
+    maxActive = 0;
+
+    height[t] = 0;
+    insertBucket(t);
+    vector<Index> order(1, t);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        Index w = order[i];
+        for (Arc a = G->firstArc(w); a < G->endArc(w); a++)
+        {
+            Index u = G->head(a);
+            if (height[u] == V && u != s && G->residual(G->reverse(a)) > 0)
+            {
+                height[u] = height[w] + 1;
+                currentArc[u] = G->firstArc(u);
+                insertBucket(u);
+                if (excess[u] > 0) { activate(u); }
+                order.push_back(u);
+            }
+        }
+    }
+    maxHeight = height[order.back()];
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::relabel(Graph* G, Index v)
+{
+    work += RELABEL_WORK + (G->endArc(v) - G->firstArc(v));
+
+    Index oldHeight = height[v], newHeight = V;
+    for (Arc a = G->firstArc(v); a < G->endArc(v); a++)
+    {
+        Index w = G->head(a);
+        if (height[w] < newHeight - 1 && G->residual(a) > 0)
+        {
+            newHeight = height[w] + 1;
+            currentArc[v] = a;
+        }
+    }
+
+    removeBucket(v);
+    if (bucketHead[oldHeight] == V)
+    {
+        /*
+         * No vertex is left on the old label, so no vertex above it can reach the sink.
+         */
+        for (Index h = oldHeight + 1; h <= maxHeight; h++)
+        {
+            for (Index u = bucketHead[h]; u != V; u = bucketNext[u])
+            {
+                height[u] = V;
+            }
+            bucketHead[h] = V;
+        }
+        height[v] = V;
+        maxHeight = oldHeight - 1;
+        return;
+    }
+
+    height[v] = newHeight;
+    if (newHeight < V)
+    {
+        insertBucket(v);
+        maxHeight = max(maxHeight, newHeight);
+    }
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::discharge(Graph* G, Index v)
+{
+    Arc end = G->endArc(v);
+    while (excess[v] > 0)
+    {
+        if (currentArc[v] == end)
+        {
+            relabel(G, v);
+            if (height[v] == V) { return; }
+            continue;
+        }
+
+        Arc a = currentArc[v];
+        Index w = G->head(a);
+        Capacity residual = G->residual(a);
+        if (residual > 0 && height[v] == height[w] + 1)
+        {
+            Capacity delta = (Capacity)min(excess[v], (long long)residual);
+            G->push(a, delta);
+            excess[v] -= delta;
+            if (!excess[w] && w != t) { activate(w); }
+            excess[w] += delta;
+        }
+        else { currentArc[v]++; }
+    }
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::maxPreflow(Graph* G)
+{
+    PERF_REGION("push-relabel:preflow");
+    for (Arc a = G->firstArc(s); a < G->endArc(s); a++)
+    {
+        Index w = G->head(a);
+        Capacity residual = G->residual(a);
+        if (w != s && residual > 0)
+        {
+            G->push(a, residual);
+            excess[w] += residual;
+            excess[s] -= residual;
+        }
+    }
+
+    globalRelabel(G);
+    double graphSize = VERTEX_WORK * (double)V + E;
+    while (true)
+    {
+        while (maxActive > 0 && active[maxActive].empty()) { maxActive--; }
+        if (active[maxActive].empty()) { break; }
+
+        Index v = active[maxActive].back();
+        active[maxActive].pop_back();
+        if (height[v] != maxActive || excess[v] <= 0) { continue; }
+
+        discharge(G, v);
+        if (work * GLOBAL_RELABEL_FREQUENCY > graphSize) { globalRelabel(G); }
+    }
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::returnExcess(Graph* G)
+{
+    PERF_REGION("push-relabel:return excess");
+
+    /*
+     * Every vertex with excess can reach the source in the residual network, so the
+     * labels start as the distances to it.
+     */
+    fill(height.begin(), height.end(), V);
+    height[s] = 0;
+    vector<Index> order(1, s);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        Index w = order[i];
+        for (Arc a = G->firstArc(w); a < G->endArc(w); a++)
+        {
+            Index u = G->head(a);
+            if (height[u] == V && u != t && G->residual(G->reverse(a)) > 0)
+            {
+                height[u] = height[w] + 1;
+                order.push_back(u);
+            }
+        }
+    }
+
+    queue<Index> q;
+    for (Index v = 0; v < V; v++)
+    {
+        currentArc[v] = G->firstArc(v);
+        if (v != s && v != t && excess[v] > 0) { q.push(v); }
+    }
+
+    while (!q.empty())
+    {
+        Index v = q.front();
+        q.pop();
+
+        Arc end = G->endArc(v);
+        while (excess[v] > 0)
+        {
+            if (currentArc[v] == end)
+            {
+                Index newHeight = numeric_limits<Index>::max();
+                for (Arc a = G->firstArc(v); a < end; a++)
+                {
+                    if (G->residual(a) > 0) { newHeight = min(newHeight, (Index)(height[G->head(a)] + 1)); }
+                }
+                height[v] = newHeight;
+                currentArc[v] = G->firstArc(v);
+                continue;
+            }
+
+            Arc a = currentArc[v];
+            Index w = G->head(a);
+            Capacity residual = G->residual(a);
+            if (residual > 0 && height[v] == height[w] + 1)
+            {
+                Capacity delta = (Capacity)min(excess[v], (long long)residual);
+                G->push(a, delta);
+                excess[v] -= delta;
+                if (!excess[w] && w != s) { q.push(w); }
+                excess[w] += delta;
+            }
+            else { currentArc[v]++; }
+        }
+    }
+}
+
+template<class Index, class Capacity>
+void PushRelabel<Index, Capacity>::markCut(Graph* G)
+{
+    visited.assign(V, false);
+    queue<Index> q;
+    q.push(s);
+    visited[s] = true;
+    while (!q.empty())
+    {
+        Index v = q.front();
+        q.pop();
+
+        for (Arc a = G->firstArc(v); a < G->endArc(v); a++)
+        {
+            Index w = G->head(a);
+            if (!visited[w] && G->residual(a) > 0)
+            {
+                visited[w] = true;
+                q.push(w);
+            }
+        }
+    }
+}
+
+template<class Index, class Capacity>
+long long PushRelabel<Index, Capacity>::flow()
+{
+    return flo;
+}
+
+template<class Index, class Capacity>
+bool PushRelabel<Index, Capacity>::inCut(Index v)
+{
+    return visited[v];
+}
+
+template<class Index, class Capacity>
+vector<Index> PushRelabel<Index, Capacity>::getCut()
+{
+    vector<Index> cut;
+    for (Index i = 0; i < V; i++)
+    {
+        if (inCut(i)) { cut.push_back(i); }
+    }
+
+    return cut;
+}
+
+
+/*
+ * The instantiations picked by dispatchFlowTypes.
+ */
+#define INSTANTIATE_PUSH_RELABEL(Index, Capacity) \
+    template class PushRelabel<Index, Capacity>;
+
+FOR_EACH_FLOW_TYPES(INSTANTIATE_PUSH_RELABEL)
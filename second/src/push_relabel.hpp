@@ -0,0 +1,179 @@
+#ifndef push_relabel_hpp
+#define push_relabel_hpp
+
+#include<vector>
+#include "flow_graph.hpp"
+
+/**
+ * Class template for Goldberg and Tarjan's push-relabel maximum flow algorithm, with the
+ * same interface as FordFulkerson.
+ *
+ * The first phase finds a maximum preflow, always discharging an active vertex of the
+ * highest label. Labels are recomputed exactly by a reverse BFS from the sink once the
+ * relabelling work reaches the size of the graph (global relabelling), and every vertex
+ * above a label left empty by a relabel is lifted out of the phase at once, as it can no
+ * longer reach the sink (gap relabelling). The second phase returns the excess left on
+ * those vertices to the source, with FIFO push-relabel on labels measured to the source,
+ * leaving a maximum flow on the edges.
+ */
+template<class Index, class Capacity>
+class PushRelabel
+{
+    private:
+        typedef FlowGraph<Index, Capacity> Graph;
+        typedef typename Graph::Arc Arc;
+
+        /**
+         * Number of vertices and edges in the digraph.
+         */
+        Index V;
+        long long E;
+
+        /**
+         * Source and sink vertices.
+         */
+        Index s, t;
+
+        /**
+         * The value of the flow in the network.
+         */
+        long long flo;
+
+        /**
+         * Flow entering every vertex less the flow leaving it.
+         */
+        std::vector<long long> excess;
+
+        /**
+         * Label of every vertex, V for the vertices out of the first phase.
+         */
+        std::vector<Index> height;
+
+        /**
+         * Next arc every vertex pushes along.
+         */
+        std::vector<Arc> currentArc;
+
+        /**
+         * Active vertices of every label, possibly with stale entries of vertices relabelled since.
+         */
+        std::vector<std::vector<Index> > active;
+
+        /**
+         * Doubly linked lists of the vertices of every label below V, ended by V.
+         */
+        std::vector<Index> bucketHead, bucketNext, bucketPrev;
+
+        /**
+         * Highest label holding an active vertex, and the highest label of any vertex, below V.
+         */
+        Index maxActive, maxHeight;
+
+        /**
+         * Relabelling work done since the last global relabelling.
+         */
+        long long work;
+
+        /**
+         * Boolean vector marking the vertices reachable from the source in the residual
+         * network of the maximum flow.
+         */
+        std::vector<bool> visited;
+
+        /**
+         * \brief Adds a vertex to the list of its label.
+         */
+        void insertBucket(Index v);
+
+        /**
+         * \brief Removes a vertex from the list of its label.
+         */
+        void removeBucket(Index v);
+
+        /**
+         * \brief Adds a vertex with excess to the active vertices of its label.
+         */
+        void activate(Index v);
+
+        /**
+         * \brief Relabels every vertex by its distance to the sink in the residual network,
+         * V if it cannot reach it, and rebuilds the lists.
+         *
+         * @param G - pointer to the flow network
+         */
+        void globalRelabel(Graph* G);
+
+        /**
+         * \brief Lifts a vertex above its lowest residual neighbour, and every vertex above its
+         * old label to V if it was the last one there.
+         *
+         * @param G - pointer to the flow network
+         * @param v - vertex to be relabelled
+         */
+        void relabel(Graph* G, Index v);
+
+        /**
+         * \brief Pushes the excess of a vertex along admissible edges, relabelling it until
+         * it has none left or its label reaches V.
+         *
+         * @param G - pointer to the flow network
+         * @param v - active vertex
+         */
+        void discharge(Graph* G, Index v);
+
+        /**
+         * \brief Finds a maximum preflow, with the highest-label rule.
+         *
+         * @param G - pointer to the flow network
+         */
+        void maxPreflow(Graph* G);
+
+        /**
+         * \brief Returns the excess left on the vertices to the source, turning the maximum
+         * preflow into a maximum flow.
+         *
+         * @param G - pointer to the flow network
+         */
+        void returnExcess(Graph* G);
+
+        /**
+         * \brief Marks the vertices reachable from the source in the residual network.
+         *
+         * @param G - pointer to the flow network
+         */
+        void markCut(Graph* G);
+
+    public:
+        /**
+         * \brief Constructor used for PushRelabel object.
+         *
+         * The constructor also runs the algorithm and finds the maximum flow, and the
+         * minimum cut solutions.
+         *
+         * @param G - pointer to the flow network
+         * @param s - source vertex
+         * @param t - sink/target vertex
+         */
+        PushRelabel(Graph* G, Index s, Index t);
+
+        /**
+         * \brief Returns the max-flow value calculated by the algorithm.
+         */
+        long long flow();
+
+        /**
+         * \brief Returns whether the vertex passed is in the given ST Cut
+         * (in the source set)
+         *
+         * @param v - vertex to be checked
+         */
+        bool inCut(Index v);
+
+        /**
+         * \brief Returns a vector of vertices present in the source set of
+         * the min cut.
+         */
+        std::vector<Index> getCut();
+};
+
+#endif